@@ -65,6 +65,105 @@
 #define ERROR_LEFT_EXPECTED_POINT MP_ERROR_TEXT("left must be a Point")
 #define ERROR_RIGHT_EXPECTED_INT MP_ERROR_TEXT("right must be a int")
 #define ERROR_MEMORY MP_ERROR_TEXT("memory allocation failed, allocating %u bytes")
+#define ERROR_CURVE_P_NOT_ODD MP_ERROR_TEXT("p of Curve must be an odd prime")
+#define ERROR_EXPECTED_POINT_OR_PUBLIC_KEY_AT_BUT MP_ERROR_TEXT("arg at index %d expected a Point or PublicKey, but %s found")
+#define ERROR_INVALID_PUBLIC_KEY MP_ERROR_TEXT("Point is not a valid public key of Curve")
+#define ERROR_CURVE_OF_PUBLIC_KEY_NOT_EQUAL MP_ERROR_TEXT("curve of PublicKey must be the same")
+#define ERROR_MSM_LENGTH MP_ERROR_TEXT("points and scalars must have the same length")
+#define ERROR_X25519_LEN MP_ERROR_TEXT("scalar and u must be 32 bytes")
+#define ERROR_ECDH_SCALAR_RANGE MP_ERROR_TEXT("d must be in the range [1, q - 1]")
+#define ERROR_ED25519_SECRET_LEN MP_ERROR_TEXT("secret must be 32 bytes")
+#define ERROR_INVALID_POINT_ENCODING MP_ERROR_TEXT("invalid SEC1 encoding of a Point of Curve")
+#define ERROR_CURVE_OID_NOT_FOUND MP_ERROR_TEXT("no Curve with this oid")
+#define ERROR_CURVE_COMPLETE_COFACTOR MP_ERROR_TEXT("complete formulas need a Curve of prime order q")
+#define ERROR_CURVE_P_TOO_WIDE MP_ERROR_TEXT("p of Curve must have at most %d bits")
+
+// width in bits of the fixed windows of the generator table
+#ifndef ECC_G_WINDOW_BITS
+#define ECC_G_WINDOW_BITS (4)
+#endif
+
+// width of the non adjacent form used for public scalars
+#ifndef ECC_WNAF_WINDOW_BITS
+#define ECC_WNAF_WINDOW_BITS (5)
+#endif
+
+// width of the non adjacent form of the cached odd multiples of the generator
+#ifndef ECC_G_WNAF_WINDOW_BITS
+#define ECC_G_WNAF_WINDOW_BITS (7)
+#endif
+
+// terms up to which msm interleaves the wNAF of the scalars (Straus), the bucket method (Pippenger) above
+#ifndef ECC_MSM_STRAUS_MAX
+#define ECC_MSM_STRAUS_MAX (96)
+#endif
+
+// widest window of the bucket method, 2^(bits-1) buckets
+#ifndef ECC_MSM_MAX_WINDOW_BITS
+#define ECC_MSM_MAX_WINDOW_BITS (10)
+#endif
+
+// width of the non adjacent form of the odd multiples cached by PublicKey
+#ifndef ECC_PUBLIC_KEY_WNAF_WINDOW_BITS
+#define ECC_PUBLIC_KEY_WNAF_WINDOW_BITS (7)
+#endif
+
+// widest p of a Curve, the largest curve enabled in tomsfastmath by default. EC field elements
+// are fixed arrays of ECC_FE_MAX_LIMBS digits instead of FP_SIZE ones
+#ifndef ECC_FE_MAX_BITS
+#if defined(TFM_ECC521)
+#define ECC_FE_MAX_BITS (521)
+#elif defined(TFM_ECC512)
+#define ECC_FE_MAX_BITS (512)
+#elif defined(TFM_ECC384)
+#define ECC_FE_MAX_BITS (384)
+#elif defined(TFM_ECC256)
+#define ECC_FE_MAX_BITS (256)
+#elif defined(TFM_ECC224)
+#define ECC_FE_MAX_BITS (224)
+#elif defined(TFM_ECC192)
+#define ECC_FE_MAX_BITS (192)
+#else
+#define ECC_FE_MAX_BITS (256)
+#endif
+#endif
+
+#define ECC_FE_MAX_LIMBS ((ECC_FE_MAX_BITS + DIGIT_BIT - 1) / DIGIT_BIT)
+
+// fp_int temporaries served by a static pool outside the GC heap, the heap is used past it.
+// without a GIL the pool is shared by the cores and is off
+#ifndef FP_SCRATCH_POOL_SIZE
+#if MICROPY_PY_THREAD && !MICROPY_PY_THREAD_GIL
+#define FP_SCRATCH_POOL_SIZE (0)
+#else
+#define FP_SCRATCH_POOL_SIZE (12)
+#endif
+#endif
+
+// counts the fp_int allocations, read and reset by _crypto.alloc_stats()
+#ifndef FP_ALLOC_STATS
+#define FP_ALLOC_STATS (0)
+#endif
+
+// values inverted together by invmod_many and normalize_batch, bounds the memory in use
+#ifndef FP_INVMOD_BATCH_CHUNK
+#define FP_INVMOD_BATCH_CHUNK (32)
+#endif
+
+// signatures verified together by ecdsa_verify_batch, bounds the memory in use
+#ifndef ECDSA_BATCH_CHUNK
+#define ECDSA_BATCH_CHUNK (16)
+#endif
+
+// Curve() shares equal curves through a registry in the VM state. the heap doesn't survive a soft reset,
+// the registry is cleared by the module __init__, which only runs with MICROPY_MODULE_BUILTIN_INIT
+#ifndef ECC_CURVE_REGISTRY
+#define ECC_CURVE_REGISTRY (MICROPY_MODULE_BUILTIN_INIT)
+#endif
+
+#if ECC_CURVE_REGISTRY && !MICROPY_MODULE_BUILTIN_INIT
+#error "ECC_CURVE_REGISTRY needs MICROPY_MODULE_BUILTIN_INIT to clear the registry on soft reset"
+#endif
 
 static vstr_t *vstr_unhexlify(vstr_t *vstr_out, const byte *in, size_t in_len)
 {
@@ -127,135 +226,392 @@ static vstr_t *vstr_hexlify(vstr_t *vstr_out, const byte *in, size_t in_len)
     return vstr_out;
 }
 
+// a = 0 touching only the digits in use and the first limbs ones
+static void fp_zero_limbs(fp_int *a, size_t limbs)
+{
+    size_t used = ((size_t)a->used > limbs) ? (size_t)a->used : limbs;
+    memset(a->dp, 0, used * sizeof(fp_digit));
+    a->used = 0;
+    a->sign = FP_ZPOS;
+}
+
+#if FP_ALLOC_STATS
+// fp_int on the heap, from the pool, on the heap because the pool was empty, peak of the pool slots in use
+static struct
+{
+    size_t heap;
+    size_t scratch;
+    size_t fallback;
+    size_t peak;
+} fp_alloc_stats;
+#endif
+
 static fp_int *fp_alloc(void)
 {
+#if FP_ALLOC_STATS
+    fp_alloc_stats.heap++;
+#endif
     fp_int *a = m_new_obj(fp_int);
     fp_init(a);
     return a;
 }
 
+#if FP_SCRATCH_POOL_SIZE > 0
+// slots never handed out start at fp_scratch_fresh, released ones are stacked in fp_scratch_released.
+// the digits past used are always zero, so a slot is cleared on release for the digits in use only
+// and is handed out again without touching the FP_SIZE digits of the whole fp_int
+static fp_int fp_scratch_pool[FP_SCRATCH_POOL_SIZE];
+static fp_int *fp_scratch_released[FP_SCRATCH_POOL_SIZE];
+static size_t fp_scratch_released_count;
+static size_t fp_scratch_fresh;
+static size_t fp_scratch_live;
+
+static void fp_scratch_reset(void)
+{
+    memset(fp_scratch_pool, 0, fp_scratch_fresh * sizeof(fp_int));
+    fp_scratch_released_count = 0;
+    fp_scratch_fresh = 0;
+    fp_scratch_live = 0;
+}
+
+static bool fp_scratch_owns(fp_int *a)
+{
+    return a >= &fp_scratch_pool[0] && a < &fp_scratch_pool[FP_SCRATCH_POOL_SIZE];
+}
+#endif
+
+// called first by the python facing functions. the module doesn't call back into python while it holds
+// temporaries, so a slot still in use here was skipped by an exception and the whole pool is taken back
+static void fp_scratch_enter(void)
+{
+#if FP_SCRATCH_POOL_SIZE > 0
+    if (fp_scratch_live > 0)
+    {
+        fp_scratch_reset();
+    }
+#endif
+}
+
+// temporary released with fp_free before returning
+static fp_int *fp_alloc_scratch(void)
+{
+#if FP_SCRATCH_POOL_SIZE > 0
+    fp_int *a = NULL;
+    if (fp_scratch_released_count > 0)
+    {
+        a = fp_scratch_released[--fp_scratch_released_count];
+    }
+    else if (fp_scratch_fresh < FP_SCRATCH_POOL_SIZE)
+    {
+        a = &fp_scratch_pool[fp_scratch_fresh++];
+    }
+    if (a != NULL)
+    {
+        fp_scratch_live++;
+#if FP_ALLOC_STATS
+        fp_alloc_stats.scratch++;
+        if (fp_scratch_live > fp_alloc_stats.peak)
+        {
+            fp_alloc_stats.peak = fp_scratch_live;
+        }
+#endif
+        return a;
+    }
+#endif
+#if FP_ALLOC_STATS
+    fp_alloc_stats.fallback++;
+#endif
+    return fp_alloc();
+}
+
 static void fp_free(fp_int *a)
 {
     if (a != NULL)
     {
+#if FP_SCRATCH_POOL_SIZE > 0
+        if (fp_scratch_owns(a))
+        {
+            fp_scratch_live--;
+            fp_zero_limbs(a, 0);
+            fp_scratch_released[fp_scratch_released_count++] = a;
+            return;
+        }
+#endif
         m_del_obj(fp_int, a);
     }
 }
 
-static mp_obj_t fp_int_as_int(fp_int *b)
+// dst = the first limbs digits of a, a < 2^(limbs * DIGIT_BIT)
+static void fp_store_limbs(fp_digit *dst, fp_int *a, size_t limbs)
 {
-    mp_obj_int_t *o = mp_obj_int_new_mpz();
-    mpz_init_zero(&o->mpz);
-
-    if (fp_iszero(b))
+    for (size_t i = 0; i < limbs; i++)
     {
-        return MP_OBJ_FROM_PTR(o);
+        dst[i] = (i < (size_t)a->used) ? a->dp[i] : 0;
     }
+}
 
-    size_t nbits = fp_count_bits(b);
-    size_t bsize = (nbits >> 3) + (nbits & 7 ? 1 : 0);
+static void fp_load_limbs(fp_int *a, const fp_digit *src, size_t limbs)
+{
+    fp_zero_limbs(a, limbs);
+    memcpy(a->dp, src, limbs * sizeof(fp_digit));
+    a->used = limbs;
+    fp_clamp(a);
+}
 
-    bool is_neg = false;
-    if (fp_cmp_d(b, 0) == FP_LT)
+// a = b if mask is all ones, a unchanged if mask is zero, without branching on mask or on the values,
+// a and b have at most limbs digits
+static void fp_cmov(fp_int *a, fp_int *b, fp_digit mask, size_t limbs)
+{
+    for (size_t i = 0; i < limbs; i++)
     {
-        is_neg = true;
+        a->dp[i] ^= (a->dp[i] ^ b->dp[i]) & mask;
     }
+    a->used ^= (a->used ^ b->used) & -(int)(mask & 1);
+}
 
-    if (is_neg)
+// b[i] = a[i]^-1 mod m for all i < n with a single inversion (Montgomery's trick), b may be a,
+// zero elements are left zero, returns FP_VAL if any other element is not invertible
+static int fp_invmod_batch(fp_int **a, fp_int **b, size_t n, fp_int *m)
+{
+    if (n == 0)
     {
-        fp_abs(b, b);
+        return FP_OKAY;
     }
 
-    byte *bb = m_new(byte, bsize);
-
-    fp_to_unsigned_bin(b, bb);
+    size_t limbs = m->used;
+    fp_digit *prefix = m_new(fp_digit, n * limbs);
+    fp_int *acc = fp_alloc_scratch();
+    fp_int *tmp = fp_alloc_scratch();
+    int res = FP_OKAY;
 
-    mpz_set_from_bytes(&o->mpz, true, bsize, bb);
-
-    m_del(byte, bb, bsize);
+    // prefix[i] = product of the non zero a[j] for j <= i
+    fp_set(acc, 1);
+    for (size_t i = 0; i < n; i++)
+    {
+        if (fp_iszero(a[i]) == FP_NO)
+        {
+            fp_mulmod(acc, a[i], m, acc);
+        }
+        fp_store_limbs(&prefix[i * limbs], acc, limbs);
+    }
 
-    if (!mpz_is_zero(&o->mpz))
+    // fp_invmod doesn't return on zero
+    if (fp_iszero(acc) == FP_YES || fp_invmod(acc, m, acc) != FP_OKAY)
+    {
+        res = FP_VAL;
+    }
+    else
     {
-        if (is_neg)
+        for (size_t i = n; i-- > 0;)
         {
-            mpz_neg_inpl(&o->mpz, &o->mpz);
+            if (fp_iszero(a[i]) == FP_YES)
+            {
+                fp_zero(b[i]);
+                continue;
+            }
+
+            // a[i]^-1 = prefix[i]^-1 * prefix[i - 1], then drop a[i] from prefix[i]^-1
+            if (i > 0)
+            {
+                fp_load_limbs(tmp, &prefix[(i - 1) * limbs], limbs);
+                fp_mulmod(acc, tmp, m, tmp);
+            }
+            else
+            {
+                fp_copy(acc, tmp);
+            }
+            fp_mulmod(acc, a[i], m, acc);
+            fp_copy(tmp, b[i]);
         }
     }
 
-    return MP_OBJ_FROM_PTR(o);
+    m_del(fp_digit, prefix, n * limbs);
+    fp_free(acc);
+    fp_free(tmp);
+    return res;
 }
 
-static size_t mpz_as_fp_int(mpz_t *i, fp_int *b)
+// b = sqrt(a) mod p for an odd prime p, returns FP_VAL if a is not a square
+static int fp_sqrtmod(fp_int *a, fp_int *p, fp_int *b)
 {
-    /* set the integer to the default of zero */
-    fp_zero(b);
+    fp_int *x = fp_alloc_scratch();
+    fp_int *e = fp_alloc_scratch();
+    fp_int *t = fp_alloc_scratch();
+    int res = FP_OKAY;
 
-    if (mpz_is_zero(i))
+    fp_mod(a, p, x);
+    if (fp_iszero(x) == FP_YES)
     {
-        return FP_OKAY;
+        fp_zero(b);
+    }
+    else if ((p->dp[0] & 3) == 3)
+    {
+        // p = 3 mod 4: b = a^((p + 1) / 4)
+        fp_add_d(p, 1, e);
+        fp_div_2d(e, 2, e, NULL);
+        fp_exptmod(x, e, p, t);
+        fp_sqrmod(t, p, e);
+        if (fp_cmp(e, x) != FP_EQ)
+        {
+            res = FP_VAL;
+        }
+        fp_copy(t, b);
     }
+    else
+    {
+        // Tonelli-Shanks, p - 1 = q * 2^s with q odd
+        fp_int *q = fp_alloc_scratch();
+        fp_int *z = fp_alloc_scratch();
+        fp_int *c = fp_alloc_scratch();
+        fp_int *r = fp_alloc_scratch();
+        fp_int *pm1 = fp_alloc_scratch();
+        int s = 0, m, i;
+
+        fp_sub_d(p, 1, pm1);
+        fp_copy(pm1, q);
+        while (fp_iseven(q) == FP_YES)
+        {
+            fp_div_2(q, q);
+            s++;
+        }
+
+        // a must be a square: a^((p - 1) / 2) = 1
+        fp_div_2(pm1, e);
+        fp_exptmod(x, e, p, t);
+        if (fp_cmp_d(t, 1) != FP_EQ)
+        {
+            res = FP_VAL;
+        }
+        else
+        {
+            // z = first non square
+            fp_set(z, 2);
+            fp_exptmod(z, e, p, t);
+            while (fp_cmp(t, pm1) != FP_EQ)
+            {
+                fp_add_d(z, 1, z);
+                fp_exptmod(z, e, p, t);
+            }
 
-    size_t nbits = mpz_max_num_bits(i);
-    size_t bsize = (nbits >> 3) + (nbits & 7 ? 1 : 0);
+            // c = z^q, t = a^q, r = a^((q + 1) / 2)
+            m = s;
+            fp_exptmod(z, q, p, c);
+            fp_exptmod(x, q, p, t);
+            fp_add_d(q, 1, e);
+            fp_div_2(e, e);
+            fp_exptmod(x, e, p, r);
 
-    byte *ib = m_new(byte, bsize);
+            while (fp_cmp_d(t, 1) != FP_EQ)
+            {
+                // least i with t^(2^i) = 1
+                fp_copy(t, e);
+                for (i = 0; i < m && fp_cmp_d(e, 1) != FP_EQ; i++)
+                {
+                    fp_sqrmod(e, p, e);
+                }
+
+                // c = c^(2^(m - i - 1)), r = r * c, c = c^2, t = t * c
+                for (int j = 0; j < m - i - 1; j++)
+                {
+                    fp_sqrmod(c, p, c);
+                }
+                m = i;
+                fp_mulmod(r, c, p, r);
+                fp_sqrmod(c, p, c);
+                fp_mulmod(t, c, p, t);
+            }
+            fp_copy(r, b);
+        }
 
-    bool is_neg = mpz_is_neg(i);
-    if (is_neg)
-    {
-        mpz_abs_inpl(i, i);
+        fp_free(q);
+        fp_free(z);
+        fp_free(c);
+        fp_free(r);
+        fp_free(pm1);
     }
 
-    mpz_as_bytes(i, true, is_neg, bsize, ib);
+    fp_free(x);
+    fp_free(e);
+    fp_free(t);
+    return res;
+}
 
-    if (is_neg)
-    {
-        mpz_neg_inpl(i, i);
-    }
+#if DIGIT_BIT % DIG_SIZE
+#error "the mpz digits must pack into the fp_digit limbs"
+#endif
 
-    fp_read_unsigned_bin(b, ib, bsize);
+// mpz digits in one fp_digit limb
+#define FP_MPZ_DIGS (DIGIT_BIT / DIG_SIZE)
 
-    m_del(byte, ib, bsize);
+static mp_obj_t fp_int_as_int(fp_int *b)
+{
+    size_t nbits = fp_count_bits(b);
 
-    /* set the sign only if b != 0 */
-    if (fp_iszero(b) != FP_YES)
+    // small ints are not boxed
+    if (nbits < (sizeof(mp_int_t) * 8) - 1)
     {
-        if (is_neg)
-        {
-            b->sign = FP_NEG;
-        }
-        else
+        mp_uint_t v = 0;
+        for (size_t i = 0; i < (size_t)b->used; i++)
         {
-            b->sign = FP_ZPOS;
+            v |= (mp_uint_t)b->dp[i] << (i * DIGIT_BIT);
         }
+        return mp_obj_new_int((b->sign == FP_NEG) ? -(mp_int_t)v : (mp_int_t)v);
     }
 
-    return FP_OKAY;
+    // repack the limbs into the DIG_SIZE bits digits of the mpz, least significant first
+    mp_obj_int_t *o = mp_obj_int_new_mpz();
+    mpz_init_zero(&o->mpz);
+    size_t len = (nbits + DIG_SIZE - 1) / DIG_SIZE;
+    o->mpz.dig = m_new(mpz_dig_t, len);
+    o->mpz.alloc = len;
+    o->mpz.len = len;
+    for (size_t i = 0; i < len; i++)
+    {
+        o->mpz.dig[i] = (mpz_dig_t)(b->dp[i / FP_MPZ_DIGS] >> ((i % FP_MPZ_DIGS) * DIG_SIZE));
+    }
+    o->mpz.neg = (b->sign == FP_NEG) ? 1 : 0;
+
+    return MP_OBJ_FROM_PTR(o);
 }
 
-static mpz_t *mp_mpz_for_int(mp_obj_t arg, mpz_t *temp)
+static void mpz_as_fp_int(const mpz_t *i, fp_int *b)
 {
-    if (MP_OBJ_IS_SMALL_INT(arg))
+    fp_zero_limbs(b, 0);
+
+    // the digits past FP_SIZE limbs are dropped, as fp_read_unsigned_bin does
+    size_t len = (i->len < FP_SIZE * FP_MPZ_DIGS) ? i->len : FP_SIZE * FP_MPZ_DIGS;
+    for (size_t d = 0; d < len; d++)
     {
-        mpz_init_from_int(temp, MP_OBJ_SMALL_INT_VALUE(arg));
-        return temp;
+        b->dp[d / FP_MPZ_DIGS] |= (fp_digit)i->dig[d] << ((d % FP_MPZ_DIGS) * DIG_SIZE);
     }
-    else
+    b->used = (len + FP_MPZ_DIGS - 1) / FP_MPZ_DIGS;
+    fp_clamp(b);
+
+    /* set the sign only if b != 0 */
+    if (fp_iszero(b) != FP_YES && i->neg)
     {
-        mp_obj_int_t *arp_p = MP_OBJ_TO_PTR(arg);
-        return &(arp_p->mpz);
+        b->sign = FP_NEG;
     }
 }
 
 static bool mp_fp_for_int(mp_obj_t arg, fp_int *ft_tmp)
 {
-    mpz_t arp_temp;
-    mpz_t *arp_p = mp_mpz_for_int(arg, &arp_temp);
-    mpz_as_fp_int(arp_p, ft_tmp);
-    if (arp_p == &arp_temp)
+    if (MP_OBJ_IS_SMALL_INT(arg))
     {
-        mpz_deinit(arp_p);
+        // straight into the limbs, without an mpz in between
+        mp_int_t value = MP_OBJ_SMALL_INT_VALUE(arg);
+        mp_uint_t v = (value < 0) ? -(mp_uint_t)value : (mp_uint_t)value;
+        fp_zero_limbs(ft_tmp, 0);
+        for (size_t i = 0; v != 0; i++)
+        {
+            ft_tmp->dp[i] = (fp_digit)v;
+            ft_tmp->used = i + 1;
+            v = (sizeof(mp_uint_t) > sizeof(fp_digit)) ? (v >> (DIGIT_BIT % (sizeof(mp_uint_t) * 8))) : 0;
+        }
+        ft_tmp->sign = (value < 0) ? FP_NEG : FP_ZPOS;
+        return true;
     }
+    mpz_as_fp_int(&((mp_obj_int_t *)MP_OBJ_TO_PTR(arg))->mpz, ft_tmp);
     return true;
 }
 
@@ -301,9 +657,9 @@ static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_ident_obj, MP_ROM_PTR(&mod_id
 
 static int fp_pow3(fp_int *X, fp_int *E, fp_int *M, fp_int *Y)
 {
-    fp_int *x = fp_alloc();
-    fp_int *e = fp_alloc();
-    fp_int *y = fp_alloc();
+    fp_int *x = fp_alloc_scratch();
+    fp_int *e = fp_alloc_scratch();
+    fp_int *y = fp_alloc_scratch();
 
     fp_copy(X, x);
     fp_copy(E, e);
@@ -342,10 +698,12 @@ static int fp_pow3(fp_int *X, fp_int *E, fp_int *M, fp_int *Y)
 
 static mp_obj_t mod_fast_pow(mp_obj_t A_in, mp_obj_t B_in, mp_obj_t C_in)
 {
-    fp_int *a_fp_int = fp_alloc();
-    fp_int *b_fp_int = fp_alloc();
-    fp_int *c_fp_int = fp_alloc();
-    fp_int *d_fp_int = fp_alloc();
+    fp_scratch_enter();
+
+    fp_int *a_fp_int = fp_alloc_scratch();
+    fp_int *b_fp_int = fp_alloc_scratch();
+    fp_int *c_fp_int = fp_alloc_scratch();
+    fp_int *d_fp_int = fp_alloc_scratch();
 
     mp_fp_for_int(A_in, a_fp_int);
     mp_fp_for_int(B_in, b_fp_int);
@@ -369,6 +727,8 @@ static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_fast_pow_obj, MP_ROM_PTR(&mod
 /* d = a**b (mod c) */
 static mp_obj_t mod_exptmod(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 {
+    fp_scratch_enter();
+
     static const mp_arg_t allowed_args[] = {
         {MP_QSTR_a, MP_ARG_OBJ, {.u_obj = mp_const_none}},
         {MP_QSTR_b, MP_ARG_OBJ, {.u_obj = mp_const_none}},
@@ -382,10 +742,10 @@ static mp_obj_t mod_exptmod(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
     } args;
     mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
 
-    fp_int *a_fp_int = fp_alloc();
-    fp_int *b_fp_int = fp_alloc();
-    fp_int *c_fp_int = fp_alloc();
-    fp_int *d_fp_int = fp_alloc();
+    fp_int *a_fp_int = fp_alloc_scratch();
+    fp_int *b_fp_int = fp_alloc_scratch();
+    fp_int *c_fp_int = fp_alloc_scratch();
+    fp_int *d_fp_int = fp_alloc_scratch();
 
     mp_fp_for_int(args.a.u_obj, a_fp_int);
     mp_fp_for_int(args.b.u_obj, b_fp_int);
@@ -404,6 +764,10 @@ static mp_obj_t mod_exptmod(size_t n_args, const mp_obj_t *pos_args, mp_map_t *k
         }
         else
         {
+            fp_free(d_fp_int);
+            fp_free(a_fp_int);
+            fp_free(b_fp_int);
+            fp_free(c_fp_int);
             mp_raise_ValueError(ERROR_ODD_MODULUS);
         }
     }
@@ -424,9 +788,11 @@ static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_exptmod_obj, MP_ROM_PTR(&mod_
 /* c = 1/a (mod b) */
 static mp_obj_t mod_invmod(mp_obj_t A_in, mp_obj_t B_in)
 {
-    fp_int *a_fp_int = fp_alloc();
-    fp_int *b_fp_int = fp_alloc();
-    fp_int *c_fp_int = fp_alloc();
+    fp_scratch_enter();
+
+    fp_int *a_fp_int = fp_alloc_scratch();
+    fp_int *b_fp_int = fp_alloc_scratch();
+    fp_int *c_fp_int = fp_alloc_scratch();
 
     mp_fp_for_int(A_in, a_fp_int);
     mp_fp_for_int(B_in, b_fp_int);
@@ -444,12 +810,77 @@ static mp_obj_t mod_invmod(mp_obj_t A_in, mp_obj_t B_in)
 static MP_DEFINE_CONST_FUN_OBJ_2(mod_invmod_obj, mod_invmod);
 static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_invmod_obj, MP_ROM_PTR(&mod_invmod_obj));
 
+/* c[i] = 1/a[i] (mod b), 0 if a[i] has no inverse */
+static mp_obj_t mod_invmod_many(mp_obj_t A_in, mp_obj_t B_in)
+{
+    fp_scratch_enter();
+
+    size_t n = 0;
+    mp_obj_t *items = NULL;
+    mp_obj_get_array(A_in, &n, &items);
+
+    size_t chunk = (n < FP_INVMOD_BATCH_CHUNK) ? n : FP_INVMOD_BATCH_CHUNK;
+    fp_int *b_fp_int = fp_alloc_scratch();
+    fp_int **a_fp_int = m_new(fp_int *, chunk);
+    for (size_t i = 0; i < chunk; i++)
+    {
+        a_fp_int[i] = fp_alloc();
+    }
+
+    mp_fp_for_int(B_in, b_fp_int);
+
+    mp_obj_t res = mp_obj_new_list(n, NULL);
+    mp_obj_t *res_items = ((mp_obj_list_t *)MP_OBJ_TO_PTR(res))->items;
+    for (size_t start = 0; start < n; start += chunk)
+    {
+        size_t count = ((n - start) < chunk) ? (n - start) : chunk;
+        for (size_t i = 0; i < count; i++)
+        {
+            mp_fp_for_int(items[start + i], a_fp_int[i]);
+            fp_mod(a_fp_int[i], b_fp_int, a_fp_int[i]);
+        }
+
+        // a value without inverse spoils the shared one, fall back to one inversion each
+        if (fp_invmod_batch(a_fp_int, a_fp_int, count, b_fp_int) != FP_OKAY)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                mp_fp_for_int(items[start + i], a_fp_int[i]);
+                fp_mod(a_fp_int[i], b_fp_int, a_fp_int[i]);
+                if (fp_iszero(a_fp_int[i]) == FP_NO && fp_invmod(a_fp_int[i], b_fp_int, a_fp_int[i]) != FP_OKAY)
+                {
+                    fp_zero(a_fp_int[i]);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            res_items[start + i] = mp_obj_new_int_from_fp(a_fp_int[i]);
+        }
+    }
+
+    for (size_t i = 0; i < chunk; i++)
+    {
+        fp_free(a_fp_int[i]);
+    }
+    m_del(fp_int *, a_fp_int, chunk);
+    fp_free(b_fp_int);
+
+    return res;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(mod_invmod_many_obj, mod_invmod_many);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_invmod_many_obj, MP_ROM_PTR(&mod_invmod_many_obj));
+
 /* c = (a, b) */
 static mp_obj_t mod_gcd(mp_obj_t A_in, mp_obj_t B_in)
 {
-    fp_int *a_fp_int = fp_alloc();
-    fp_int *b_fp_int = fp_alloc();
-    fp_int *c_fp_int = fp_alloc();
+    fp_scratch_enter();
+
+    fp_int *a_fp_int = fp_alloc_scratch();
+    fp_int *b_fp_int = fp_alloc_scratch();
+    fp_int *c_fp_int = fp_alloc_scratch();
 
     mp_fp_for_int(A_in, a_fp_int);
     mp_fp_for_int(B_in, b_fp_int);
@@ -481,6 +912,8 @@ static int ucrypto_rng(unsigned char *dst, int len, void *dat)
 /* generate prime number */
 static mp_obj_t mod_generate_prime(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 {
+    fp_scratch_enter();
+
     static const mp_arg_t allowed_args[] = {
         {MP_QSTR_num, MP_ARG_INT, {.u_int = 1024}},
         {MP_QSTR_test, MP_ARG_INT, {.u_int = 25}},
@@ -521,6 +954,8 @@ static MP_DEFINE_CONST_STATICMETHOD_OBJ(mod_static_generate_prime_obj, MP_ROM_PT
 
 static mp_obj_t mod_is_prime(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 {
+    fp_scratch_enter();
+
     static const mp_arg_t allowed_args[] = {
         {MP_QSTR_a, MP_ARG_OBJ, {.u_obj = mp_const_none}},
         {MP_QSTR_test, MP_ARG_INT, {.u_int = 25}},
@@ -536,7 +971,7 @@ static mp_obj_t mod_is_prime(size_t n_args, const mp_obj_t *pos_args, mp_map_t *
         mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT, mp_obj_get_type_str(args.a.u_obj));
     }
 
-    fp_int *a_fp_int = fp_alloc();
+    fp_int *a_fp_int = fp_alloc_scratch();
 
     mp_fp_for_int(args.a.u_obj, a_fp_int);
 
@@ -561,6 +996,7 @@ static const mp_rom_map_elem_t number_locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_exptmod), MP_ROM_PTR(&mod_static_exptmod_obj)},
     {MP_ROM_QSTR(MP_QSTR_fast_pow), MP_ROM_PTR(&mod_static_fast_pow_obj)},
     {MP_ROM_QSTR(MP_QSTR_invmod), MP_ROM_PTR(&mod_static_invmod_obj)},
+    {MP_ROM_QSTR(MP_QSTR_invmod_many), MP_ROM_PTR(&mod_static_invmod_many_obj)},
     {MP_ROM_QSTR(MP_QSTR_gcd), MP_ROM_PTR(&mod_static_gcd_obj)},
     {MP_ROM_QSTR(MP_QSTR_generate_prime), MP_ROM_PTR(&mod_static_generate_prime_obj)},
     {MP_ROM_QSTR(MP_QSTR_is_prime), MP_ROM_PTR(&mod_static_is_prime_obj)},
@@ -582,6 +1018,80 @@ typedef struct _ecc_point_t
     fp_int *y;
 } ecc_point_t;
 
+// element of the field of a curve as the limbs of p, little endian, in [0, p) and in the domain of the
+// field backend. the digits past the limbs of p are unused
+typedef struct _ec_fe_t
+{
+    fp_digit dp[ECC_FE_MAX_LIMBS];
+} ec_fe_t;
+
+// point in jacobian coordinates (X:Y:Z), affine (X/Z^2, Y/Z^3), identity has Z = 0
+typedef struct _ecc_jacobian_point_t
+{
+    ec_fe_t x;
+    ec_fe_t y;
+    ec_fe_t z;
+} ecc_jacobian_point_t;
+
+// affine odd multiples (2i + 1) * P for i < 2^(w - 2) as limbs in the montgomery domain, (0, 0) is the identity element
+typedef struct _ecc_odd_multiples_t
+{
+    int w;
+    size_t limbs;
+    fp_digit *points;
+} ecc_odd_multiples_t;
+
+// fixed-window table of the generator, shared by all copies of a curve and built on first use:
+// window i holds the affine points (2j + 1) * 2^(w * i) * G for j < 2^(w - 1), in the montgomery domain
+typedef struct _ecc_generator_table_t
+{
+    bool failed;
+    size_t bits;
+    size_t windows;
+    size_t limbs;
+    fp_digit *points;
+    // odd multiples of G for the wNAF paths
+    ecc_odd_multiples_t *odd;
+} ecc_generator_table_t;
+
+struct _ecc_curve_t;
+
+// GLV endomorphism (x, y) -> (beta * x, y) = lambda * (x, y) of y^2 = x^3 + b over the field of a backend
+// for the subgroup of order q, with the short basis (a1, b1), (a2, b2) of the lattice of the decompositions
+// k = k1 + k2 * lambda mod q, as little endian 32-bit words
+typedef struct _ecc_glv_t
+{
+    size_t words;
+    const uint32_t *q;
+    const uint32_t *beta;
+    const uint32_t *a1;
+    const uint32_t *minus_b1;
+    const uint32_t *a2;
+    const uint32_t *b2;
+} ecc_glv_t;
+
+// reduction backend of the field of a curve, reduce maps the 2 * limbs digits 0 <= t < p^2 to c = t / R mod p
+// and clobbers t. the generic backend is montgomery reduction, the specialised ones are selected by p
+// and work on the plain residues (R = 1)
+typedef struct _ecc_field_t
+{
+    bool montgomery;
+    // p as little endian 32-bit words, unused by the generic backend
+    const uint32_t *p;
+    size_t words;
+    void (*reduce)(ec_fe_t *c, fp_digit *t, struct _ecc_curve_t *curve);
+    // endomorphism of the curves with a = 0, if any
+    const ecc_glv_t *glv;
+} ecc_field_t;
+
+// complete addition and doubling in projective coordinates (X : Y : Z), x = X / Z, y = Y / Z,
+// valid for every input including the identity element (0 : 1 : 0) on curves of odd order
+typedef struct _ecc_complete_t
+{
+    void (*add)(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, struct _ecc_curve_t *curve);
+    void (*dbl)(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, struct _ecc_curve_t *curve);
+} ecc_complete_t;
+
 // curve over a prime field
 typedef struct _ecc_curve_t
 {
@@ -592,6 +1102,28 @@ typedef struct _ecc_curve_t
     ecc_point_t *g;
     vstr_t name;
     vstr_t oid;
+    // hash of p, a, b, q and G for the registry and the equality checks
+    uint32_t hash;
+    // domain of p: field backend, limbs of p, p as a field element, rho, R^2 mod p, R mod p (one)
+    // and a * R mod p
+    const ecc_field_t *field;
+    size_t limbs;
+    ec_fe_t pl;
+    fp_digit mp;
+    ec_fe_t r2;
+    ec_fe_t one;
+    ec_fe_t am;
+    // a = -3 mod p, selects the doubling
+    bool a_minus_3;
+    void (*dbl)(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, struct _ecc_curve_t *curve);
+    // endomorphism used by the wNAF paths when q matches, beta in the domain of p
+    const ecc_glv_t *glv;
+    ec_fe_t beta;
+    ecc_generator_table_t *gtable;
+    // complete formulas used by the point multiplications when enabled, b and 3 * b in the domain of p
+    const ecc_complete_t *complete;
+    ec_fe_t bm;
+    ec_fe_t b3m;
 } ecc_curve_t;
 
 typedef struct _ecdsa_signature_t
@@ -619,1258 +1151,5727 @@ typedef struct _mp_ecdsa_signature_t
     ecdsa_signature_t *ecdsa_signature;
 } mp_ecdsa_signature_t;
 
+// validated public key with the odd multiples of its point, for repeated verifications
+typedef struct _mp_public_key_t
+{
+    mp_obj_base_t base;
+    mp_point_t *point;
+    ecc_odd_multiples_t *odd;
+} mp_public_key_t;
+
 const mp_obj_type_t signature_type;
 const mp_obj_type_t curve_type;
 const mp_obj_type_t point_type;
+const mp_obj_type_t public_key_type;
 const mp_obj_type_t ecc_type;
 
-static mp_curve_t *new_curve_init_copy(mp_point_t *point)
+// i-th 32-bit word of a, a >= 0
+static uint32_t fp_word32(fp_int *a, size_t i)
 {
-    mp_curve_t *c = m_new_obj(mp_curve_t);
-    c->base.type = &curve_type;
-    c->ecc_curve = m_new_obj(ecc_curve_t);
-    c->ecc_curve->p = fp_alloc();
-    c->ecc_curve->a = fp_alloc();
-    c->ecc_curve->b = fp_alloc();
-    c->ecc_curve->q = fp_alloc();
-    c->ecc_curve->g = m_new_obj(ecc_point_t);
-    c->ecc_curve->g->x = fp_alloc();
-    c->ecc_curve->g->y = fp_alloc();
-
-    vstr_init(&c->ecc_curve->name, vstr_len(&point->ecc_curve->oid));
-    vstr_add_strn(&c->ecc_curve->name, vstr_str(&point->ecc_curve->name), vstr_len(&point->ecc_curve->name));
-    vstr_init(&c->ecc_curve->oid, vstr_len(&point->ecc_curve->oid));
-    vstr_add_strn(&c->ecc_curve->oid, vstr_str(&point->ecc_curve->oid), vstr_len(&point->ecc_curve->oid));
-
-    fp_copy(point->ecc_curve->p, c->ecc_curve->p);
-    fp_copy(point->ecc_curve->a, c->ecc_curve->a);
-    fp_copy(point->ecc_curve->b, c->ecc_curve->b);
-    fp_copy(point->ecc_curve->q, c->ecc_curve->q);
-    fp_copy(point->ecc_curve->g->x, c->ecc_curve->g->x);
-    fp_copy(point->ecc_curve->g->y, c->ecc_curve->g->y);
-
-    return c;
+    size_t digit = (i * 32) / DIGIT_BIT;
+    return (digit < (size_t)a->used) ? (uint32_t)(a->dp[digit] >> ((i * 32) % DIGIT_BIT)) : 0;
 }
 
-static mp_point_t *new_point_init_copy(mp_curve_t *curve)
+static bool fp_equal_words32(fp_int *a, const uint32_t *w, size_t n)
 {
-    mp_point_t *pr = m_new_obj(mp_point_t);
-    pr->base.type = &point_type;
-
-    pr->ecc_curve = m_new_obj(ecc_curve_t);
-    pr->ecc_curve->p = fp_alloc();
-    pr->ecc_curve->a = fp_alloc();
-    pr->ecc_curve->b = fp_alloc();
-    pr->ecc_curve->q = fp_alloc();
-    pr->ecc_curve->g = m_new_obj(ecc_point_t);
-    pr->ecc_curve->g->x = fp_alloc();
-    pr->ecc_curve->g->y = fp_alloc();
-    pr->ecc_point = m_new_obj(ecc_point_t);
-    pr->ecc_point->x = fp_alloc();
-    pr->ecc_point->y = fp_alloc();
+    if (a->sign == FP_NEG || (size_t)fp_count_bits(a) > n * 32)
+    {
+        return false;
+    }
+    for (size_t i = 0; i < n; i++)
+    {
+        if (fp_word32(a, i) != w[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
 
-    vstr_init(&pr->ecc_curve->name, vstr_len(&curve->ecc_curve->oid));
-    vstr_add_strn(&pr->ecc_curve->name, vstr_str(&curve->ecc_curve->name), vstr_len(&curve->ecc_curve->name));
-    vstr_init(&pr->ecc_curve->oid, vstr_len(&curve->ecc_curve->oid));
-    vstr_add_strn(&pr->ecc_curve->oid, vstr_str(&curve->ecc_curve->oid), vstr_len(&curve->ecc_curve->oid));
-
-    fp_copy(curve->ecc_curve->p, pr->ecc_curve->p);
-    fp_copy(curve->ecc_curve->a, pr->ecc_curve->a);
-    fp_copy(curve->ecc_curve->b, pr->ecc_curve->b);
-    fp_copy(curve->ecc_curve->q, pr->ecc_curve->q);
-    fp_copy(curve->ecc_curve->g->x, pr->ecc_curve->g->x);
-    fp_copy(curve->ecc_curve->g->y, pr->ecc_curve->g->y);
-    fp_copy(curve->ecc_curve->g->x, pr->ecc_point->x);
-    fp_copy(curve->ecc_curve->g->y, pr->ecc_point->y);
-    return pr;
+// a = the n 32-bit words of w
+static void fp_store_words32(fp_int *a, const uint32_t *w, size_t n)
+{
+    fp_zero_limbs(a, (n * 32 + DIGIT_BIT - 1) / DIGIT_BIT);
+    for (size_t i = 0; i < n; i++)
+    {
+        a->dp[(i * 32) / DIGIT_BIT] |= (fp_digit)w[i] << ((i * 32) % DIGIT_BIT);
+    }
+    a->used = (n * 32 + DIGIT_BIT - 1) / DIGIT_BIT;
+    fp_clamp(a);
 }
 
-static bool ec_signature_equal(ecdsa_signature_t *s1, ecdsa_signature_t *s2)
+// c = a - p if a + carry * 2^(DIGIT_BIT * limbs) >= p, a otherwise, for a + carry * 2^(DIGIT_BIT * limbs) < 2p.
+// c may be a, without branching on the values
+static void ec_fe_reduce_once(ec_fe_t *c, const fp_digit *a, fp_digit carry, ecc_curve_t *curve)
 {
-    if (fp_cmp(s1->r, s2->r) != FP_EQ)
+    size_t limbs = curve->limbs;
+    fp_digit d[ECC_FE_MAX_LIMBS];
+    fp_digit borrow = 0;
+
+    for (size_t i = 0; i < limbs; i++)
     {
-        return false;
+        fp_word t = (fp_word)a[i] - curve->pl.dp[i] - borrow;
+        d[i] = (fp_digit)t;
+        borrow = (fp_digit)(t >> DIGIT_BIT) & 1;
     }
-    if (fp_cmp(s1->s, s2->s) != FP_EQ)
+
+    // a is kept if a - p borrowed past the carry
+    fp_digit keep = (fp_digit)0 - (borrow & (carry ^ 1));
+    for (size_t i = 0; i < limbs; i++)
     {
-        return false;
+        c->dp[i] = (a[i] & keep) | (d[i] & ~keep);
     }
-    return true;
 }
 
-static void signature_print(mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+// i-th 32-bit word of the limbs t
+static uint32_t ec_limbs_word32(const fp_digit *t, size_t i)
 {
-    (void)kind;
-    mp_ecdsa_signature_t *self = MP_OBJ_TO_PTR(self_in);
-    vstr_t *vstr_r = vstr_new_from_fp(self->ecdsa_signature->r);
-    vstr_t *vstr_s = vstr_new_from_fp(self->ecdsa_signature->s);
-    mp_printf(print, "<Signature r=%s s=%s>", vstr_str(vstr_r), vstr_str(vstr_s));
-    vstr_free(vstr_r);
-    vstr_free(vstr_s);
+    return (uint32_t)(t[(i * 32) / DIGIT_BIT] >> ((i * 32) % DIGIT_BIT));
 }
 
-static mp_obj_t signature_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
+// c = the n 32-bit words of w reduced once modulo p, w < 2p
+static void ec_fe_store_words32(ec_fe_t *c, const uint32_t *w, size_t n, ecc_curve_t *curve)
 {
-    switch (op)
+    fp_digit a[ECC_FE_MAX_LIMBS];
+
+    memset(a, 0, sizeof(a));
+    for (size_t i = 0; i < n; i++)
     {
-    case MP_BINARY_OP_EQUAL:
+        a[(i * 32) / DIGIT_BIT] |= (fp_digit)w[i] << ((i * 32) % DIGIT_BIT);
+    }
+    ec_fe_reduce_once(c, a, 0, curve);
+}
+
+// c = t / R mod p, R = 2^(DIGIT_BIT * limbs): every row adds the multiple of p that clears its low digit,
+// the carries out of the top digit are kept in hi instead of being rippled up
+static void ec_field_montgomery_reduce(ec_fe_t *c, fp_digit *t, ecc_curve_t *curve)
+{
+    size_t limbs = curve->limbs;
+    const fp_digit *p = curve->pl.dp;
+    fp_digit hi = 0;
+
+    for (size_t i = 0; i < limbs; i++)
     {
-        if (!MP_OBJ_IS_TYPE(lhs, &signature_type) && !MP_OBJ_IS_TYPE(rhs, &signature_type))
+        fp_digit u = t[i] * curve->mp;
+        fp_word carry = 0;
+        for (size_t j = 0; j < limbs; j++)
         {
-            mp_raise_TypeError(ERROR_EXPECTED_SIGNATURES);
+            carry += (fp_word)u * p[j] + t[i + j];
+            t[i + j] = (fp_digit)carry;
+            carry >>= DIGIT_BIT;
         }
-        mp_ecdsa_signature_t *l = MP_OBJ_TO_PTR(lhs);
-        mp_ecdsa_signature_t *r = MP_OBJ_TO_PTR(rhs);
-        return mp_obj_new_bool(ec_signature_equal(l->ecdsa_signature, r->ecdsa_signature));
-    }
-    default:
-        return MP_OBJ_NULL; // op not supported
+        carry += (fp_word)t[i + limbs] + hi;
+        t[i + limbs] = (fp_digit)carry;
+        hi = (fp_digit)(carry >> DIGIT_BIT);
     }
+
+    // t / R < 2p
+    ec_fe_reduce_once(c, &t[limbs], hi, curve);
 }
 
-static void signature_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
+// c = sum of w[i] * 2^(32 * i) mod p for the n signed word sums w of a solinas reduction, where fold
+// holds the signed words of 2^(32 * n) mod p and p > 2^(32 * n - 1)
+static void ec_field_solinas_carry(ec_fe_t *c, int64_t *w, const int16_t *fold, size_t n, ecc_curve_t *curve)
 {
-    mp_ecdsa_signature_t *self = MP_OBJ_TO_PTR(obj);
-    if (dest[0] == MP_OBJ_NULL)
+    uint32_t words[12];
+    int64_t carry = 0;
+
+    // propagate the carries and fold the one out of the top word back until it is zero
+    do
     {
-        const mp_obj_type_t *type = mp_obj_get_type(obj);
-        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
-        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
-        if (elem != NULL)
+        for (size_t i = 0; i < n; i++)
         {
-            if (attr == MP_QSTR_r)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecdsa_signature->r);
-                return;
-            }
-            else if (attr == MP_QSTR_s)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecdsa_signature->s);
-                return;
-            }
-            mp_convert_member_lookup(obj, type, elem->value, dest);
+            w[i] += fold[i] * carry;
+        }
+        carry = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            w[i] += carry;
+            carry = w[i] >> 32;
+            w[i] &= 0xffffffff;
         }
+    } while (carry != 0);
+
+    // c < 2^(32 * n) < 2 * p
+    for (size_t i = 0; i < n; i++)
+    {
+        words[i] = (uint32_t)w[i];
     }
+    ec_fe_store_words32(c, words, n, curve);
 }
 
-static const mp_rom_map_elem_t signature_locals_dict_table[] = {
-    {MP_ROM_QSTR(MP_QSTR_s), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_r), MP_ROM_INT(0)},
-};
-
-static MP_DEFINE_CONST_DICT(signature_locals_dict, signature_locals_dict_table);
-
-MP_DEFINE_CONST_OBJ_TYPE(
-    signature_type,
-    MP_QSTR_Signature,
-    MP_TYPE_FLAG_NONE,
-    print, signature_print,
-    binary_op, signature_binary_op,
-    attr, signature_attr,
-    locals_dict, &signature_locals_dict);
-
-static bool ec_point_in_curve(ecc_point_t *point, ecc_curve_t *curve)
+// p = 2^256 - 2^224 + 2^192 + 2^96 - 1, FIPS 186-4 D.2.3: the 32-bit words c15..c8 of the high half
+// are folded into the low half with 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p
+static void ec_field_p256_reduce(ec_fe_t *r, fp_digit *t, ecc_curve_t *curve)
 {
-    int is_point_in_curve = 0;
-    fp_int *x = fp_alloc();
-    fp_int *y = fp_alloc();
-    fp_int *left = fp_alloc();
-    fp_int *right = fp_alloc();
-    fp_int *x_mul_x_mul_x = fp_alloc();
-    fp_int *curvea_mul_x = fp_alloc();
-    fp_int *left_minus_right_mod_curvep = fp_alloc();
+    static const int16_t fold[8] = {1, 0, 0, -1, 0, 0, -1, 1};
+    int64_t c[16], w[8];
 
-    fp_copy(point->x, x);
-    fp_copy(point->y, y);
+    for (size_t i = 0; i < 16; i++)
+    {
+        c[i] = ec_limbs_word32(t, i);
+    }
 
-    /*
-    left = y * y
-    right = (x * x * x) + (self.a * x) + self.b
-    return (left - right) % self.p == 0
-    */
+    w[0] = c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    w[1] = c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    w[2] = c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    w[3] = c[3] - c[8] - c[9] + 2 * c[11] + 2 * c[12] + c[13] - c[15];
+    w[4] = c[4] - c[9] - c[10] + 2 * c[12] + 2 * c[13] + c[14];
+    w[5] = c[5] - c[10] - c[11] + 2 * c[13] + 2 * c[14] + c[15];
+    w[6] = c[6] - c[8] - c[9] + c[13] + 3 * c[14] + 2 * c[15];
+    w[7] = c[7] + c[8] - c[10] - c[11] - c[12] - c[13] + 3 * c[15];
 
-    // left = (y * y)
-    fp_sqr(y, left);
+    ec_field_solinas_carry(r, w, fold, 8, curve);
+}
 
-    //(x * x * x)
-    fp_mul(x, x, x_mul_x_mul_x);
-    fp_mul(x_mul_x_mul_x, x, x_mul_x_mul_x);
+// p = 2^384 - 2^128 - 2^96 + 2^32 - 1, FIPS 186-4 D.2.4: the sums T + 2 S1 + S2 + ... + S6 - D1 - D2 - D3
+// collected per word, with 2^384 = 2^128 + 2^96 - 2^32 + 1 mod p
+static void ec_field_p384_reduce(ec_fe_t *r, fp_digit *t, ecc_curve_t *curve)
+{
+    static const int16_t fold[12] = {1, -1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+    int64_t c[24], w[12];
 
-    //(curve.a * x)
-    fp_mul(curve->a, x, curvea_mul_x);
+    for (size_t i = 0; i < 24; i++)
+    {
+        c[i] = ec_limbs_word32(t, i);
+    }
 
-    // right = (x * x * x) + (curve.a * x) + curve.b
-    fp_add(x_mul_x_mul_x, curvea_mul_x, right);
-    fp_add(right, curve->b, right);
+    w[0] = c[0] + c[12] + c[20] + c[21] - c[23];
+    w[1] = c[1] - c[12] + c[13] - c[20] + c[22] + c[23];
+    w[2] = c[2] - c[13] + c[14] - c[21] + c[23];
+    w[3] = c[3] + c[12] - c[14] + c[15] + c[20] + c[21] - c[22] - c[23];
+    w[4] = c[4] + c[12] + c[13] - c[15] + c[16] + c[20] + 2 * c[21] + c[22] - 2 * c[23];
+    w[5] = c[5] + c[13] + c[14] - c[16] + c[17] + c[21] + 2 * c[22] + c[23];
+    w[6] = c[6] + c[14] + c[15] - c[17] + c[18] + c[22] + 2 * c[23];
+    w[7] = c[7] + c[15] + c[16] - c[18] + c[19] + c[23];
+    w[8] = c[8] + c[16] + c[17] - c[19] + c[20];
+    w[9] = c[9] + c[17] + c[18] - c[20] + c[21];
+    w[10] = c[10] + c[18] + c[19] - c[21] + c[22];
+    w[11] = c[11] + c[19] + c[20] - c[22] + c[23];
+
+    ec_field_solinas_carry(r, w, fold, 12, curve);
+}
 
-    // return (left - right) % curve.p == 0
-    fp_submod(left, right, curve->p, left_minus_right_mod_curvep);
-    is_point_in_curve = (fp_iszero(left_minus_right_mod_curvep) == FP_YES);
+// p = 2^256 - 2^32 - 977, pseudo-mersenne: the high half is folded in with 2^256 = 2^32 + 977 mod p
+static void ec_field_secp256k1_reduce(ec_fe_t *r, fp_digit *t, ecc_curve_t *curve)
+{
+    static const int16_t fold[8] = {977, 1, 0, 0, 0, 0, 0, 0};
+    uint32_t words[16];
+    int64_t w[8];
 
-    fp_free(left);
-    fp_free(x_mul_x_mul_x);
-    fp_free(curvea_mul_x);
-    fp_free(right);
-    fp_free(left_minus_right_mod_curvep);
-    fp_free(x);
-    fp_free(y);
+    for (size_t i = 0; i < 16; i++)
+    {
+        words[i] = ec_limbs_word32(t, i);
+    }
+    for (size_t i = 0; i < 8; i++)
+    {
+        w[i] = (int64_t)words[i] + 977 * (int64_t)words[8 + i] + ((i > 0) ? (int64_t)words[7 + i] : 0);
+    }
+    // words[15] * 2^32 lands on 2^256 once more
+    w[0] += 977 * (int64_t)words[15];
+    w[1] += words[15];
 
-    return is_point_in_curve;
+    ec_field_solinas_carry(r, w, fold, 8, curve);
 }
 
-static bool ec_curve_equal(ecc_curve_t *c1, ecc_curve_t *c2)
+// p = 2^521 - 1: t = lo + hi * 2^521 = lo + hi mod p
+static void ec_field_p521_reduce(ec_fe_t *r, fp_digit *t, ecc_curve_t *curve)
 {
-    if (fp_cmp(c1->p, c2->p) != FP_EQ)
+    uint32_t c[34], w[17];
+    uint64_t carry = 0;
+
+    for (size_t i = 0; i < 34; i++)
     {
-        return false;
+        c[i] = ec_limbs_word32(t, i);
     }
-    if (fp_cmp(c1->a, c2->a) != FP_EQ)
+    for (size_t i = 0; i < 17; i++)
     {
-        return false;
+        uint64_t lo = (i < 16) ? c[i] : (c[16] & 0x1ff);
+        uint64_t hi = ((c[16 + i] >> 9) | ((uint64_t)c[17 + i] << 23)) & 0xffffffff;
+        carry += lo + hi;
+        w[i] = (uint32_t)carry;
+        carry >>= 32;
     }
-    if (fp_cmp(c1->b, c2->b) != FP_EQ)
+
+    // lo + hi < 2^522, fold bit 521 back once more
+    carry = w[16] >> 9;
+    w[16] &= 0x1ff;
+    for (size_t i = 0; i < 17; i++)
     {
-        return false;
+        carry += w[i];
+        w[i] = (uint32_t)carry;
+        carry >>= 32;
     }
-    if (fp_cmp(c1->q, c2->q) != FP_EQ)
+
+    // w <= p, p itself reduces to 0
+    ec_fe_store_words32(r, w, 17, curve);
+}
+
+static const uint32_t ec_field_p256_prime[8] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff};
+
+static const uint32_t ec_field_p384_prime[12] = {
+    0xffffffff, 0x00000000, 0x00000000, 0xffffffff, 0xfffffffe, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+
+static const uint32_t ec_field_p521_prime[17] = {
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff,
+    0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x000001ff};
+
+static const uint32_t ec_field_secp256k1_prime[8] = {
+    0xfffffc2f, 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff};
+
+static const uint32_t ec_glv_secp256k1_q[8] = {
+    0xd0364141, 0xbfd25e8c, 0xaf48a03b, 0xbaaedce6, 0xfffffffe, 0xffffffff, 0xffffffff, 0xffffffff};
+static const uint32_t ec_glv_secp256k1_beta[8] = {
+    0x719501ee, 0xc1396c28, 0x12f58995, 0x9cf04975, 0xac3434e9, 0x6e64479e, 0x657c0710, 0x7ae96a2b};
+static const uint32_t ec_glv_secp256k1_a1[8] = {
+    0x9284eb15, 0xe86c90e4, 0xa7d46bcd, 0x3086d221, 0x00000000, 0x00000000, 0x00000000, 0x00000000};
+static const uint32_t ec_glv_secp256k1_minus_b1[8] = {
+    0x0abfe4c3, 0x6f547fa9, 0x010e8828, 0xe4437ed6, 0x00000000, 0x00000000, 0x00000000, 0x00000000};
+static const uint32_t ec_glv_secp256k1_a2[8] = {
+    0x9d44cfd8, 0x57c1108d, 0xa8e2f3f6, 0x14ca50f7, 0x00000001, 0x00000000, 0x00000000, 0x00000000};
+
+// lambda = 0x5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72
+static const ecc_glv_t ec_glv_secp256k1 = {
+    8,
+    ec_glv_secp256k1_q,
+    ec_glv_secp256k1_beta,
+    ec_glv_secp256k1_a1,
+    ec_glv_secp256k1_minus_b1,
+    ec_glv_secp256k1_a2,
+    ec_glv_secp256k1_a1,
+};
+
+static const ecc_field_t ec_field_montgomery = {true, NULL, 0, ec_field_montgomery_reduce, NULL};
+static const ecc_field_t ec_field_p256 = {false, ec_field_p256_prime, 8, ec_field_p256_reduce, NULL};
+static const ecc_field_t ec_field_p384 = {false, ec_field_p384_prime, 12, ec_field_p384_reduce, NULL};
+static const ecc_field_t ec_field_p521 = {false, ec_field_p521_prime, 17, ec_field_p521_reduce, NULL};
+static const ecc_field_t ec_field_secp256k1 = {false, ec_field_secp256k1_prime, 8, ec_field_secp256k1_reduce, &ec_glv_secp256k1};
+
+// specialised backends, looked up by p
+static const ecc_field_t *const ec_fields[] = {
+    &ec_field_p256,
+    &ec_field_p384,
+    &ec_field_p521,
+    &ec_field_secp256k1,
+};
+
+static const ecc_field_t *ec_field_select(fp_int *p)
+{
+    for (size_t i = 0; i < MP_ARRAY_SIZE(ec_fields); i++)
     {
-        return false;
+        if (fp_equal_words32(p, ec_fields[i]->p, ec_fields[i]->words))
+        {
+            return ec_fields[i];
+        }
     }
-    if (fp_cmp(c1->g->x, c2->g->x) != FP_EQ)
+    return &ec_field_montgomery;
+}
+
+// field arithmetic over curve->p on the limbs of ec_fe_t, operands and results in the domain of curve->field
+// (the montgomery domain, or the plain residues for the specialised backends)
+
+// c = a for 0 <= a < p, and back
+static void ec_fe_from_fp(ec_fe_t *c, fp_int *a, ecc_curve_t *curve)
+{
+    fp_store_limbs(c->dp, a, curve->limbs);
+}
+
+static void ec_fe_to_fp(fp_int *c, ec_fe_t *a, ecc_curve_t *curve)
+{
+    fp_load_limbs(c, a->dp, curve->limbs);
+}
+
+// dst = the first limbs digits of a, for the tables of points
+static void ec_fe_store(fp_digit *dst, ec_fe_t *a, size_t limbs)
+{
+    memcpy(dst, a->dp, limbs * sizeof(fp_digit));
+}
+
+static void ec_fe_load(ec_fe_t *c, const fp_digit *src, size_t limbs)
+{
+    memcpy(c->dp, src, limbs * sizeof(fp_digit));
+}
+
+static void ec_fe_zero(ec_fe_t *c, ecc_curve_t *curve)
+{
+    memset(c->dp, 0, curve->limbs * sizeof(fp_digit));
+}
+
+static bool ec_fe_iszero(ec_fe_t *a, ecc_curve_t *curve)
+{
+    fp_digit d = 0;
+    for (size_t i = 0; i < curve->limbs; i++)
     {
-        return false;
+        d |= a->dp[i];
     }
-    if (fp_cmp(c1->g->y, c2->g->y) != FP_EQ)
+    return d == 0;
+}
+
+static bool ec_fe_equal(ec_fe_t *a, ec_fe_t *b, ecc_curve_t *curve)
+{
+    fp_digit d = 0;
+    for (size_t i = 0; i < curve->limbs; i++)
     {
-        return false;
+        d |= a->dp[i] ^ b->dp[i];
     }
-    return true;
+    return d == 0;
 }
 
-static mp_obj_t curve_equal(mp_obj_t curve1, mp_obj_t curve2)
+// t = a * b, 2 * limbs digits
+static void ec_fe_mul_limbs(fp_digit *t, const fp_digit *a, const fp_digit *b, size_t limbs)
 {
-    if (!MP_OBJ_IS_TYPE(curve1, &curve_type))
+    memset(t, 0, 2 * limbs * sizeof(fp_digit));
+    for (size_t i = 0; i < limbs; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 1, mp_obj_get_type_str(curve1));
+        fp_word carry = 0;
+        for (size_t j = 0; j < limbs; j++)
+        {
+            carry += (fp_word)a[i] * b[j] + t[i + j];
+            t[i + j] = (fp_digit)carry;
+            carry >>= DIGIT_BIT;
+        }
+        t[i + limbs] = (fp_digit)carry;
     }
-    if (!MP_OBJ_IS_TYPE(curve2, &curve_type))
+}
+
+// t = a^2, 2 * limbs digits: the products a[i] * a[j] for i < j once, doubled, plus the squares
+static void ec_fe_sqr_limbs(fp_digit *t, const fp_digit *a, size_t limbs)
+{
+    memset(t, 0, 2 * limbs * sizeof(fp_digit));
+    for (size_t i = 0; i + 1 < limbs; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve2));
+        fp_word carry = 0;
+        for (size_t j = i + 1; j < limbs; j++)
+        {
+            carry += (fp_word)a[i] * a[j] + t[i + j];
+            t[i + j] = (fp_digit)carry;
+            carry >>= DIGIT_BIT;
+        }
+        t[i + limbs] = (fp_digit)carry;
     }
 
-    mp_curve_t *c1 = MP_OBJ_TO_PTR(curve1);
-    mp_curve_t *c2 = MP_OBJ_TO_PTR(curve2);
-    return mp_obj_new_bool(ec_curve_equal(c1->ecc_curve, c2->ecc_curve));
+    fp_digit top = 0;
+    for (size_t i = 0; i < 2 * limbs; i++)
+    {
+        fp_digit d = t[i];
+        t[i] = (d << 1) | top;
+        top = d >> (DIGIT_BIT - 1);
+    }
+
+    fp_word carry = 0;
+    for (size_t i = 0; i < limbs; i++)
+    {
+        fp_word sq = (fp_word)a[i] * a[i];
+        carry += (fp_word)t[2 * i] + (fp_digit)sq;
+        t[2 * i] = (fp_digit)carry;
+        carry >>= DIGIT_BIT;
+        carry += (fp_word)t[2 * i + 1] + (fp_digit)(sq >> DIGIT_BIT);
+        t[2 * i + 1] = (fp_digit)carry;
+        carry >>= DIGIT_BIT;
+    }
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_2(curve_equal_obj, curve_equal);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_curve_equal_obj, MP_ROM_PTR(&curve_equal_obj));
+static void ec_fe_mul(ec_fe_t *c, ec_fe_t *a, ec_fe_t *b, ecc_curve_t *curve)
+{
+    fp_digit t[2 * ECC_FE_MAX_LIMBS];
+    ec_fe_mul_limbs(t, a->dp, b->dp, curve->limbs);
+    curve->field->reduce(c, t, curve);
+}
 
-static mp_obj_t point_in_curve(mp_obj_t point, mp_obj_t curve)
+static void ec_fe_sqr(ec_fe_t *c, ec_fe_t *a, ecc_curve_t *curve)
 {
-    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    fp_digit t[2 * ECC_FE_MAX_LIMBS];
+    ec_fe_sqr_limbs(t, a->dp, curve->limbs);
+    curve->field->reduce(c, t, curve);
+}
+
+static void ec_fe_add(ec_fe_t *c, ec_fe_t *a, ec_fe_t *b, ecc_curve_t *curve)
+{
+    fp_digit t[ECC_FE_MAX_LIMBS];
+    fp_word carry = 0;
+
+    for (size_t i = 0; i < curve->limbs; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+        carry += (fp_word)a->dp[i] + b->dp[i];
+        t[i] = (fp_digit)carry;
+        carry >>= DIGIT_BIT;
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    ec_fe_reduce_once(c, t, (fp_digit)carry, curve);
+}
+
+static void ec_fe_sub(ec_fe_t *c, ec_fe_t *a, ec_fe_t *b, ecc_curve_t *curve)
+{
+    fp_digit t[ECC_FE_MAX_LIMBS];
+    fp_digit borrow = 0;
+
+    for (size_t i = 0; i < curve->limbs; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
+        fp_word d = (fp_word)a->dp[i] - b->dp[i] - borrow;
+        t[i] = (fp_digit)d;
+        borrow = (fp_digit)(d >> DIGIT_BIT) & 1;
     }
 
-    mp_point_t *p = MP_OBJ_TO_PTR(point);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
-    return mp_obj_new_bool(ec_point_in_curve(p->ecc_point, c->ecc_curve));
+    // a - b + p if it borrowed
+    fp_digit mask = (fp_digit)0 - borrow;
+    fp_word carry = 0;
+    for (size_t i = 0; i < curve->limbs; i++)
+    {
+        carry += (fp_word)t[i] + (curve->pl.dp[i] & mask);
+        c->dp[i] = (fp_digit)carry;
+        carry >>= DIGIT_BIT;
+    }
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_2(point_in_curve_obj, point_in_curve);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_in_curve_obj, MP_ROM_PTR(&point_in_curve_obj));
+static void ec_fe_neg(ec_fe_t *c, ec_fe_t *a, ecc_curve_t *curve)
+{
+    ec_fe_t zero;
+    ec_fe_zero(&zero, curve);
+    ec_fe_sub(c, &zero, a, curve);
+}
 
-static void curve_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+// c = a * R mod p
+static void ec_fe_to_montgomery(ec_fe_t *c, ec_fe_t *a, ecc_curve_t *curve)
 {
-    (void)kind;
-    mp_curve_t *self = MP_OBJ_TO_PTR(self_in);
-    vstr_t vstr_oid;
-    vstr_hexlify(&vstr_oid, (const byte *)vstr_str(&self->ecc_curve->oid), vstr_len(&self->ecc_curve->oid));
-    vstr_t *ecc_curve_p = vstr_new_from_fp(self->ecc_curve->p);
-    vstr_t *ecc_curve_a = vstr_new_from_fp(self->ecc_curve->a);
-    vstr_t *ecc_curve_b = vstr_new_from_fp(self->ecc_curve->b);
-    vstr_t *ecc_curve_q = vstr_new_from_fp(self->ecc_curve->q);
-    vstr_t *ecc_curve_g_x = vstr_new_from_fp(self->ecc_curve->g->x);
-    vstr_t *ecc_curve_g_y = vstr_new_from_fp(self->ecc_curve->g->y);
-    mp_printf(print, "<Curve name=%s oid=%s p=%s a=%s b=%s q=%s gx=%s gy=%s>", vstr_str(&self->ecc_curve->name), vstr_str(&vstr_oid), vstr_str(ecc_curve_p), vstr_str(ecc_curve_a), vstr_str(ecc_curve_b), vstr_str(ecc_curve_q), vstr_str(ecc_curve_g_x), vstr_str(ecc_curve_g_y));
-    vstr_free(ecc_curve_p);
-    vstr_free(ecc_curve_a);
-    vstr_free(ecc_curve_b);
-    vstr_free(ecc_curve_q);
-    vstr_free(ecc_curve_g_x);
-    vstr_free(ecc_curve_g_y);
+    if (curve->field->montgomery)
+    {
+        ec_fe_mul(c, a, &curve->r2, curve);
+    }
+    else
+    {
+        *c = *a;
+    }
 }
 
-static mp_obj_t curve_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
+// c = a / R mod p
+static void ec_fe_from_montgomery(ec_fe_t *c, ec_fe_t *a, ecc_curve_t *curve)
 {
-    switch (op)
+    if (curve->field->montgomery)
     {
-    case MP_BINARY_OP_EQUAL:
+        fp_digit t[2 * ECC_FE_MAX_LIMBS];
+        memcpy(t, a->dp, curve->limbs * sizeof(fp_digit));
+        memset(&t[curve->limbs], 0, curve->limbs * sizeof(fp_digit));
+        ec_field_montgomery_reduce(c, t, curve);
+    }
+    else
     {
-        if (!MP_OBJ_IS_TYPE(lhs, &curve_type) && !MP_OBJ_IS_TYPE(rhs, &curve_type))
-        {
-            mp_raise_TypeError(ERROR_EXPECTED_CURVES);
-        }
-        mp_curve_t *l = MP_OBJ_TO_PTR(lhs);
-        mp_curve_t *r = MP_OBJ_TO_PTR(rhs);
-        return curve_equal(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r));
+        *c = *a;
     }
-    case MP_BINARY_OP_CONTAINS:
+}
+
+// c = a^-1 for a != 0, with fp_invmod on the plain residue
+static void ec_fe_invert(ec_fe_t *c, ec_fe_t *a, ecc_curve_t *curve)
+{
+    fp_int *t = fp_alloc_scratch();
+
+    ec_fe_from_montgomery(c, a, curve);
+    ec_fe_to_fp(t, c, curve);
+    fp_invmod(t, curve->p, t);
+    ec_fe_from_fp(c, t, curve);
+    ec_fe_to_montgomery(c, c, curve);
+
+    fp_free(t);
+}
+
+// enables the endomorphism of the field backend for a = 0 and the matching q, to be redone when any of them changes
+static void ec_curve_glv_setup(ecc_curve_t *curve)
+{
+    const ecc_glv_t *glv = curve->field->glv;
+
+    curve->glv = NULL;
+    if (glv != NULL && fp_iszero(curve->a) == FP_YES && fp_equal_words32(curve->q, glv->q, glv->words))
     {
-        if (!MP_OBJ_IS_TYPE(lhs, &curve_type))
-        {
-            mp_raise_TypeError(ERROR_LEFT_EXPECTED_CURVE);
-        }
-        if (!MP_OBJ_IS_TYPE(rhs, &point_type))
-        {
-            mp_raise_TypeError(ERROR_RIGHT_EXPECTED_POINT);
-        }
-        mp_curve_t *l = MP_OBJ_TO_PTR(lhs);
-        mp_point_t *r = MP_OBJ_TO_PTR(rhs);
-        return point_in_curve(MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(l));
+        fp_int *t = fp_alloc_scratch();
+        fp_store_words32(t, glv->beta, glv->words);
+        ec_fe_from_fp(&curve->beta, t, curve);
+        ec_fe_to_montgomery(&curve->beta, &curve->beta, curve);
+        fp_free(t);
+        curve->glv = glv;
     }
-    default:
-        return MP_OBJ_NULL; // op not supported
+}
+
+static void ec_jacobian_double_generic(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve);
+static void ec_jacobian_double_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve);
+static void ec_complete_add(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve);
+static void ec_complete_double(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve);
+static void ec_complete_add_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve);
+static void ec_complete_double_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve);
+
+// Renes, Costello, Batina, algorithms 1 and 3 for any a, 4 and 6 for a = -3
+static const ecc_complete_t ec_complete_generic = {ec_complete_add, ec_complete_double};
+static const ecc_complete_t ec_complete_a3 = {ec_complete_add_a3, ec_complete_double_a3};
+
+static bool ec_curve_a_is_minus_3(ecc_curve_t *curve)
+{
+    fp_int *t = fp_alloc_scratch();
+    fp_add_d(curve->a, 3, t);
+    fp_mod(t, curve->p, t);
+    bool minus_3 = (fp_iszero(t) == FP_YES);
+    fp_free(t);
+    return minus_3;
+}
+
+// true if every point of the curve but the identity has order q: by Hasse the curve has at most
+// p + 1 + 2 * sqrt(p) points, 2q more than that leaves no room for a cofactor of 2 or more
+static bool ec_curve_cofactor_is_one(ecc_curve_t *curve)
+{
+    fp_int *bound = fp_alloc_scratch();
+    fp_int *t = fp_alloc_scratch();
+
+    // 2 * sqrt(p) < 2^(ceil(bits(p) / 2) + 1)
+    fp_2expt(bound, (fp_count_bits(curve->p) + 1) / 2 + 1);
+    fp_add(bound, curve->p, bound);
+    fp_add_d(bound, 1, bound);
+    fp_add(curve->q, curve->q, t);
+    bool one = (fp_cmp(t, bound) == FP_GT);
+
+    fp_free(bound);
+    fp_free(t);
+    return one;
+}
+
+// m = h * q, the number of points of the curve, with the cofactor h = round((p + 1) / q): by Hasse
+// |h * q - (p + 1)| <= 2 * sqrt(p), less than q / 2 once q > 4 * sqrt(p). returns false for a smaller q
+static bool ec_curve_order(fp_int *m, ecc_curve_t *curve)
+{
+    // 4 * sqrt(p) < 2^(ceil(bits(p) / 2) + 2) <= q
+    if (fp_count_bits(curve->q) < (fp_count_bits(curve->p) + 1) / 2 + 3)
+    {
+        return false;
     }
+
+    fp_int *t = fp_alloc_scratch();
+    fp_div_2(curve->q, t);
+    fp_add(t, curve->p, t);
+    fp_add_d(t, 1, t);
+    fp_div(t, curve->q, t, NULL);
+    fp_mul(t, curve->q, m);
+    fp_free(t);
+    return true;
 }
 
-static void curve_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
+static void ec_curve_field_setup(ecc_curve_t *curve)
 {
-    mp_curve_t *self = MP_OBJ_TO_PTR(obj);
-    if (dest[0] == MP_OBJ_NULL)
+    if (fp_cmp_d(curve->p, 2) != FP_GT || fp_montgomery_setup(curve->p, &curve->mp) != FP_OKAY)
     {
-        const mp_obj_type_t *type = mp_obj_get_type(obj);
-        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
-        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
-        if (elem != NULL)
-        {
-            if (attr == MP_QSTR_p)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->p);
-                return;
-            }
-            else if (attr == MP_QSTR_a)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->a);
-                return;
-            }
-            else if (attr == MP_QSTR_b)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->b);
-                return;
-            }
-            else if (attr == MP_QSTR_q)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->q);
-                return;
-            }
-            else if (attr == MP_QSTR_G)
-            {
-                mp_point_t *pr = new_point_init_copy(self);
-                dest[0] = pr;
-                return;
-            }
-            else if (attr == MP_QSTR_gx)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->g->x);
-                return;
-            }
-            else if (attr == MP_QSTR_gy)
-            {
-                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->g->y);
-                return;
-            }
-            else if (attr == MP_QSTR_name)
+        mp_raise_ValueError(ERROR_CURVE_P_NOT_ODD);
+    }
+
+    if (fp_count_bits(curve->p) > ECC_FE_MAX_BITS)
+    {
+        mp_raise_msg_varg(&mp_type_ValueError, ERROR_CURVE_P_TOO_WIDE, ECC_FE_MAX_BITS);
+    }
+
+    curve->limbs = curve->p->used;
+    fp_store_limbs(curve->pl.dp, curve->p, curve->limbs);
+    curve->field = ec_field_select(curve->p);
+
+    // one = R mod p, r2 = R^2 mod p
+    fp_int *t = fp_alloc_scratch();
+    if (curve->field->montgomery)
+    {
+        fp_montgomery_calc_normalization(t, curve->p);
+        ec_fe_from_fp(&curve->one, t, curve);
+        fp_sqrmod(t, curve->p, t);
+        ec_fe_from_fp(&curve->r2, t, curve);
+    }
+    else
+    {
+        fp_set(t, 1);
+        ec_fe_from_fp(&curve->one, t, curve);
+        ec_fe_from_fp(&curve->r2, t, curve);
+    }
+
+    // am = a * R mod p, bm = b * R mod p, b3m = 3 * b * R mod p
+    fp_mod(curve->a, curve->p, t);
+    ec_fe_from_fp(&curve->am, t, curve);
+    ec_fe_to_montgomery(&curve->am, &curve->am, curve);
+    fp_mod(curve->b, curve->p, t);
+    ec_fe_from_fp(&curve->bm, t, curve);
+    ec_fe_to_montgomery(&curve->bm, &curve->bm, curve);
+    ec_fe_add(&curve->b3m, &curve->bm, &curve->bm, curve);
+    ec_fe_add(&curve->b3m, &curve->b3m, &curve->bm, curve);
+    fp_free(t);
+
+    curve->a_minus_3 = ec_curve_a_is_minus_3(curve);
+    curve->dbl = curve->a_minus_3 ? ec_jacobian_double_a3 : ec_jacobian_double_generic;
+    if (curve->complete != NULL)
+    {
+        curve->complete = curve->a_minus_3 ? &ec_complete_a3 : &ec_complete_generic;
+    }
+
+    ec_curve_glv_setup(curve);
+}
+
+static ecc_generator_table_t *ec_generator_table_new(void)
+{
+    ecc_generator_table_t *table = m_new_obj(ecc_generator_table_t);
+    table->failed = false;
+    table->bits = 0;
+    table->windows = 0;
+    table->limbs = 0;
+    table->points = NULL;
+    table->odd = NULL;
+    return table;
+}
+
+static void ec_curve_precomp_copy(ecc_curve_t *dst, ecc_curve_t *src)
+{
+    dst->field = src->field;
+    dst->limbs = src->limbs;
+    dst->pl = src->pl;
+    dst->mp = src->mp;
+    dst->r2 = src->r2;
+    dst->one = src->one;
+    dst->am = src->am;
+    dst->a_minus_3 = src->a_minus_3;
+    dst->dbl = src->dbl;
+    dst->glv = src->glv;
+    dst->beta = src->beta;
+    dst->gtable = src->gtable;
+    dst->complete = src->complete;
+    dst->bm = src->bm;
+    dst->b3m = src->b3m;
+}
+
+// curve with zero parameters and empty name and oid
+static ecc_curve_t *ec_curve_alloc(void)
+{
+    ecc_curve_t *curve = m_new_obj(ecc_curve_t);
+    curve->p = fp_alloc();
+    curve->a = fp_alloc();
+    curve->b = fp_alloc();
+    curve->q = fp_alloc();
+    curve->g = m_new_obj(ecc_point_t);
+    curve->g->x = fp_alloc();
+    curve->g->y = fp_alloc();
+    vstr_init(&curve->name, 0);
+    vstr_init(&curve->oid, 0);
+    return curve;
+}
+
+// deep copy of a curve, for the setters of Curve: points share their curve, which is never changed in place
+static ecc_curve_t *ec_curve_copy(ecc_curve_t *src)
+{
+    ecc_curve_t *dst = ec_curve_alloc();
+    vstr_add_strn(&dst->name, vstr_str(&src->name), vstr_len(&src->name));
+    vstr_add_strn(&dst->oid, vstr_str(&src->oid), vstr_len(&src->oid));
+
+    fp_copy(src->p, dst->p);
+    fp_copy(src->a, dst->a);
+    fp_copy(src->b, dst->b);
+    fp_copy(src->q, dst->q);
+    fp_copy(src->g->x, dst->g->x);
+    fp_copy(src->g->y, dst->g->y);
+    dst->hash = src->hash;
+    ec_curve_precomp_copy(dst, src);
+    return dst;
+}
+
+static mp_curve_t *new_curve_init_shared(ecc_curve_t *curve)
+{
+    mp_curve_t *c = m_new_obj(mp_curve_t);
+    c->base.type = &curve_type;
+    c->ecc_curve = curve;
+    return c;
+}
+
+// new point on curve, set to its generator
+static mp_point_t *new_point_init_shared(ecc_curve_t *curve)
+{
+    mp_point_t *pr = m_new_obj(mp_point_t);
+    pr->base.type = &point_type;
+    pr->ecc_curve = curve;
+    pr->ecc_point = m_new_obj(ecc_point_t);
+    pr->ecc_point->x = fp_alloc();
+    pr->ecc_point->y = fp_alloc();
+    fp_copy(curve->g->x, pr->ecc_point->x);
+    fp_copy(curve->g->y, pr->ecc_point->y);
+    return pr;
+}
+
+static bool ec_signature_equal(ecdsa_signature_t *s1, ecdsa_signature_t *s2)
+{
+    if (fp_cmp(s1->r, s2->r) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(s1->s, s2->s) != FP_EQ)
+    {
+        return false;
+    }
+    return true;
+}
+
+static void signature_print(mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    (void)kind;
+    mp_ecdsa_signature_t *self = MP_OBJ_TO_PTR(self_in);
+    vstr_t *vstr_r = vstr_new_from_fp(self->ecdsa_signature->r);
+    vstr_t *vstr_s = vstr_new_from_fp(self->ecdsa_signature->s);
+    mp_printf(print, "<Signature r=%s s=%s>", vstr_str(vstr_r), vstr_str(vstr_s));
+    vstr_free(vstr_r);
+    vstr_free(vstr_s);
+}
+
+static mp_obj_t signature_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
+{
+    fp_scratch_enter();
+
+    switch (op)
+    {
+    case MP_BINARY_OP_EQUAL:
+    {
+        if (!MP_OBJ_IS_TYPE(lhs, &signature_type) && !MP_OBJ_IS_TYPE(rhs, &signature_type))
+        {
+            mp_raise_TypeError(ERROR_EXPECTED_SIGNATURES);
+        }
+        mp_ecdsa_signature_t *l = MP_OBJ_TO_PTR(lhs);
+        mp_ecdsa_signature_t *r = MP_OBJ_TO_PTR(rhs);
+        return mp_obj_new_bool(ec_signature_equal(l->ecdsa_signature, r->ecdsa_signature));
+    }
+    default:
+        return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static void signature_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
+{
+    fp_scratch_enter();
+
+    mp_ecdsa_signature_t *self = MP_OBJ_TO_PTR(obj);
+    if (dest[0] == MP_OBJ_NULL)
+    {
+        const mp_obj_type_t *type = mp_obj_get_type(obj);
+        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        if (elem != NULL)
+        {
+            if (attr == MP_QSTR_r)
             {
-                dest[0] = mp_obj_new_str_of_type(&mp_type_str, (const byte *)vstr_str(&self->ecc_curve->name), vstr_len(&self->ecc_curve->name));
+                dest[0] = mp_obj_new_int_from_fp(self->ecdsa_signature->r);
                 return;
             }
-            else if (attr == MP_QSTR_oid)
+            else if (attr == MP_QSTR_s)
             {
-                dest[0] = mp_obj_new_str_of_type(&mp_type_bytes, (const byte *)vstr_str(&self->ecc_curve->oid), vstr_len(&self->ecc_curve->oid));
+                dest[0] = mp_obj_new_int_from_fp(self->ecdsa_signature->s);
                 return;
             }
             mp_convert_member_lookup(obj, type, elem->value, dest);
         }
     }
+}
+
+static const mp_rom_map_elem_t signature_locals_dict_table[] = {
+    {MP_ROM_QSTR(MP_QSTR_s), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_r), MP_ROM_INT(0)},
+};
+
+static MP_DEFINE_CONST_DICT(signature_locals_dict, signature_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    signature_type,
+    MP_QSTR_Signature,
+    MP_TYPE_FLAG_NONE,
+    print, signature_print,
+    binary_op, signature_binary_op,
+    attr, signature_attr,
+    locals_dict, &signature_locals_dict);
+
+static bool ec_point_in_curve(ecc_point_t *point, ecc_curve_t *curve)
+{
+    int is_point_in_curve = 0;
+    fp_int *x = fp_alloc_scratch();
+    fp_int *y = fp_alloc_scratch();
+    fp_int *left = fp_alloc_scratch();
+    fp_int *right = fp_alloc_scratch();
+    fp_int *x_mul_x_mul_x = fp_alloc_scratch();
+    fp_int *curvea_mul_x = fp_alloc_scratch();
+    fp_int *left_minus_right_mod_curvep = fp_alloc_scratch();
+
+    fp_copy(point->x, x);
+    fp_copy(point->y, y);
+
+    /*
+    left = y * y
+    right = (x * x * x) + (self.a * x) + self.b
+    return (left - right) % self.p == 0
+    */
+
+    // left = (y * y)
+    fp_sqr(y, left);
+
+    //(x * x * x)
+    fp_mul(x, x, x_mul_x_mul_x);
+    fp_mul(x_mul_x_mul_x, x, x_mul_x_mul_x);
+
+    //(curve.a * x)
+    fp_mul(curve->a, x, curvea_mul_x);
+
+    // right = (x * x * x) + (curve.a * x) + curve.b
+    fp_add(x_mul_x_mul_x, curvea_mul_x, right);
+    fp_add(right, curve->b, right);
+
+    // return (left - right) % curve.p == 0
+    fp_submod(left, right, curve->p, left_minus_right_mod_curvep);
+    is_point_in_curve = (fp_iszero(left_minus_right_mod_curvep) == FP_YES);
+
+    fp_free(left);
+    fp_free(x_mul_x_mul_x);
+    fp_free(curvea_mul_x);
+    fp_free(right);
+    fp_free(left_minus_right_mod_curvep);
+    fp_free(x);
+    fp_free(y);
+
+    return is_point_in_curve;
+}
+
+// length in bytes of a coordinate in the SEC1 encoding of the points of curve
+static size_t ec_point_coordinate_len(ecc_curve_t *curve)
+{
+    return (fp_count_bits(curve->p) + 7) / 8;
+}
+
+// out = SEC1 encoding of point: 0x00 for the identity, 0x04 || x || y, or 0x02 + (y & 1) || x if compressed,
+// returns its length, out must hold 1 + 2 * ec_point_coordinate_len(curve) bytes
+static size_t ec_point_encode(byte *out, ecc_point_t *point, bool compressed, ecc_curve_t *curve)
+{
+    if (fp_iszero(point->x) == FP_YES && fp_iszero(point->y) == FP_YES)
+    {
+        out[0] = 0x00;
+        return 1;
+    }
+
+    size_t len = ec_point_coordinate_len(curve);
+    fp_int *t = fp_alloc_scratch();
+
+    fp_mod(point->y, curve->p, t);
+    out[0] = compressed ? (0x02 | (fp_isodd(t) == FP_YES)) : 0x04;
+    if (!compressed)
+    {
+        memset(&out[1 + len], 0, len);
+        fp_to_unsigned_bin(t, &out[1 + 2 * len - fp_unsigned_bin_size(t)]);
+    }
+    fp_mod(point->x, curve->p, t);
+    memset(&out[1], 0, len);
+    fp_to_unsigned_bin(t, &out[1 + len - fp_unsigned_bin_size(t)]);
+
+    fp_free(t);
+    return compressed ? 1 + len : 1 + 2 * len;
+}
+
+// point = SEC1 decoding of in, returns false if in is not the encoding of a point of curve,
+// y of a compressed point is the root of x^3 + a * x + b with the parity of the prefix
+static bool ec_point_decode(ecc_point_t *point, const byte *in, size_t in_len, ecc_curve_t *curve)
+{
+    size_t len = ec_point_coordinate_len(curve);
+
+    if (in_len == 1 && in[0] == 0x00)
+    {
+        fp_zero(point->x);
+        fp_zero(point->y);
+        return true;
+    }
+    if (!((in_len == 1 + 2 * len && in[0] == 0x04) || (in_len == 1 + len && (in[0] == 0x02 || in[0] == 0x03))))
+    {
+        return false;
+    }
+
+    fp_read_unsigned_bin(point->x, (const unsigned char *)&in[1], len);
+    if (fp_cmp(point->x, curve->p) != FP_LT)
+    {
+        return false;
+    }
+
+    if (in[0] == 0x04)
+    {
+        fp_read_unsigned_bin(point->y, (const unsigned char *)&in[1 + len], len);
+        return fp_cmp(point->y, curve->p) == FP_LT && ec_point_in_curve(point, curve);
+    }
+
+    // y^2 = x^3 + a * x + b
+    fp_int *t = fp_alloc_scratch();
+    fp_sqrmod(point->x, curve->p, t);
+    fp_add(t, curve->a, t);
+    fp_mulmod(t, point->x, curve->p, t);
+    fp_add(t, curve->b, t);
+    bool valid = (fp_sqrtmod(t, curve->p, point->y) == FP_OKAY);
+    if (valid && (fp_isodd(point->y) == FP_YES) != (in[0] == 0x03))
+    {
+        // -y, but y = 0 has no odd root
+        valid = (fp_iszero(point->y) == FP_NO);
+        fp_sub(curve->p, point->y, point->y);
+    }
+    fp_free(t);
+    return valid;
+}
+
+// FNV-1a of the sign and the digits of a
+static uint32_t ec_hash_fp(uint32_t hash, fp_int *a)
+{
+    hash = (hash ^ (uint32_t)a->sign) * 16777619u;
+    for (int i = 0; i < a->used; i++)
+    {
+        fp_digit d = a->dp[i];
+        for (size_t j = 0; j < sizeof(fp_digit); j++, d >>= 8)
+        {
+            hash = (hash ^ (uint32_t)(d & 0xff)) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+static uint32_t ec_curve_hash(ecc_curve_t *curve)
+{
+    uint32_t hash = 2166136261u;
+    hash = ec_hash_fp(hash, curve->p);
+    hash = ec_hash_fp(hash, curve->a);
+    hash = ec_hash_fp(hash, curve->b);
+    hash = ec_hash_fp(hash, curve->q);
+    hash = ec_hash_fp(hash, curve->g->x);
+    hash = ec_hash_fp(hash, curve->g->y);
+    return hash;
+}
+
+static bool ec_curve_equal(ecc_curve_t *c1, ecc_curve_t *c2)
+{
+    // curves made with the same parameters are interned, different hashes are different curves
+    if (c1 == c2)
+    {
+        return true;
+    }
+    if (c1->hash != c2->hash)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->p, c2->p) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->a, c2->a) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->b, c2->b) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->q, c2->q) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->g->x, c2->g->x) != FP_EQ)
+    {
+        return false;
+    }
+    if (fp_cmp(c1->g->y, c2->g->y) != FP_EQ)
+    {
+        return false;
+    }
+    return true;
+}
+
+static mp_obj_t curve_equal(mp_obj_t curve1, mp_obj_t curve2)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(curve1, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 1, mp_obj_get_type_str(curve1));
+    }
+    if (!MP_OBJ_IS_TYPE(curve2, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve2));
+    }
+
+    mp_curve_t *c1 = MP_OBJ_TO_PTR(curve1);
+    mp_curve_t *c2 = MP_OBJ_TO_PTR(curve2);
+    return mp_obj_new_bool(ec_curve_equal(c1->ecc_curve, c2->ecc_curve));
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(curve_equal_obj, curve_equal);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_curve_equal_obj, MP_ROM_PTR(&curve_equal_obj));
+
+static mp_obj_t point_in_curve(mp_obj_t point, mp_obj_t curve)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *p = MP_OBJ_TO_PTR(point);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+    return mp_obj_new_bool(ec_point_in_curve(p->ecc_point, c->ecc_curve));
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(point_in_curve_obj, point_in_curve);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_in_curve_obj, MP_ROM_PTR(&point_in_curve_obj));
+
+static void curve_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    (void)kind;
+    mp_curve_t *self = MP_OBJ_TO_PTR(self_in);
+    vstr_t vstr_oid;
+    vstr_hexlify(&vstr_oid, (const byte *)vstr_str(&self->ecc_curve->oid), vstr_len(&self->ecc_curve->oid));
+    vstr_t *ecc_curve_p = vstr_new_from_fp(self->ecc_curve->p);
+    vstr_t *ecc_curve_a = vstr_new_from_fp(self->ecc_curve->a);
+    vstr_t *ecc_curve_b = vstr_new_from_fp(self->ecc_curve->b);
+    vstr_t *ecc_curve_q = vstr_new_from_fp(self->ecc_curve->q);
+    vstr_t *ecc_curve_g_x = vstr_new_from_fp(self->ecc_curve->g->x);
+    vstr_t *ecc_curve_g_y = vstr_new_from_fp(self->ecc_curve->g->y);
+    mp_printf(print, "<Curve name=%s oid=%s p=%s a=%s b=%s q=%s gx=%s gy=%s>", vstr_str(&self->ecc_curve->name), vstr_str(&vstr_oid), vstr_str(ecc_curve_p), vstr_str(ecc_curve_a), vstr_str(ecc_curve_b), vstr_str(ecc_curve_q), vstr_str(ecc_curve_g_x), vstr_str(ecc_curve_g_y));
+    vstr_free(ecc_curve_p);
+    vstr_free(ecc_curve_a);
+    vstr_free(ecc_curve_b);
+    vstr_free(ecc_curve_q);
+    vstr_free(ecc_curve_g_x);
+    vstr_free(ecc_curve_g_y);
+}
+
+static mp_obj_t curve_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
+{
+    fp_scratch_enter();
+
+    switch (op)
+    {
+    case MP_BINARY_OP_EQUAL:
+    {
+        if (!MP_OBJ_IS_TYPE(lhs, &curve_type) && !MP_OBJ_IS_TYPE(rhs, &curve_type))
+        {
+            mp_raise_TypeError(ERROR_EXPECTED_CURVES);
+        }
+        mp_curve_t *l = MP_OBJ_TO_PTR(lhs);
+        mp_curve_t *r = MP_OBJ_TO_PTR(rhs);
+        return curve_equal(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r));
+    }
+    case MP_BINARY_OP_CONTAINS:
+    {
+        if (!MP_OBJ_IS_TYPE(lhs, &curve_type))
+        {
+            mp_raise_TypeError(ERROR_LEFT_EXPECTED_CURVE);
+        }
+        if (!MP_OBJ_IS_TYPE(rhs, &point_type))
+        {
+            mp_raise_TypeError(ERROR_RIGHT_EXPECTED_POINT);
+        }
+        mp_curve_t *l = MP_OBJ_TO_PTR(lhs);
+        mp_point_t *r = MP_OBJ_TO_PTR(rhs);
+        return point_in_curve(MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(l));
+    }
+    default:
+        return MP_OBJ_NULL; // op not supported
+    }
+}
+
+#if ECC_CURVE_REGISTRY
+// curves made by Curve() or changed by its setters, interned by hash with linear probing: equal curves
+// share the native object of the first one. once the table is full new curves are just not shared
+MP_REGISTER_ROOT_POINTER(void *ucrypto_curves[16]);
+
+// same parameters, name, oid and engine
+static bool ec_curve_identical(ecc_curve_t *c1, ecc_curve_t *c2)
+{
+    return ec_curve_equal(c1, c2) && (c1->complete != NULL) == (c2->complete != NULL) &&
+           vstr_len(&c1->name) == vstr_len(&c2->name) && memcmp(vstr_str(&c1->name), vstr_str(&c2->name), vstr_len(&c1->name)) == 0 &&
+           vstr_len(&c1->oid) == vstr_len(&c2->oid) && memcmp(vstr_str(&c1->oid), vstr_str(&c2->oid), vstr_len(&c1->oid)) == 0;
+}
+
+static ecc_curve_t *ec_curve_registry_lookup(ecc_curve_t *curve)
+{
+    size_t n = MP_ARRAY_SIZE(MP_STATE_VM(ucrypto_curves));
+    for (size_t i = 0; i < n; i++)
+    {
+        ecc_curve_t *entry = MP_STATE_VM(ucrypto_curves)[(curve->hash + i) % n];
+        if (entry == NULL)
+        {
+            break;
+        }
+        if (ec_curve_identical(entry, curve))
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void ec_curve_registry_add(ecc_curve_t *curve)
+{
+    size_t n = MP_ARRAY_SIZE(MP_STATE_VM(ucrypto_curves));
+    for (size_t i = 0; i < n; i++)
+    {
+        size_t slot = (curve->hash + i) % n;
+        if (MP_STATE_VM(ucrypto_curves)[slot] == NULL)
+        {
+            MP_STATE_VM(ucrypto_curves)[slot] = curve;
+            return;
+        }
+    }
+}
+#else
+static ecc_curve_t *ec_curve_registry_lookup(ecc_curve_t *curve)
+{
+    (void)curve;
+    return NULL;
+}
+
+static void ec_curve_registry_add(ecc_curve_t *curve)
+{
+    (void)curve;
+}
+#endif
+
+// the shared curve equal to a new one, whose field setup and generator table are made if it's the first
+static ecc_curve_t *ec_curve_intern(ecc_curve_t *curve)
+{
+    curve->hash = ec_curve_hash(curve);
+    ecc_curve_t *interned = ec_curve_registry_lookup(curve);
+    if (interned != NULL)
+    {
+        return interned;
+    }
+
+    ec_curve_field_setup(curve);
+    curve->gtable = ec_generator_table_new();
+    ec_curve_registry_add(curve);
+    return curve;
+}
+
+static void curve_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
+{
+    fp_scratch_enter();
+
+    mp_curve_t *self = MP_OBJ_TO_PTR(obj);
+    if (dest[0] == MP_OBJ_NULL)
+    {
+        const mp_obj_type_t *type = mp_obj_get_type(obj);
+        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        if (elem != NULL)
+        {
+            if (attr == MP_QSTR_p)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->p);
+                return;
+            }
+            else if (attr == MP_QSTR_a)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->a);
+                return;
+            }
+            else if (attr == MP_QSTR_b)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->b);
+                return;
+            }
+            else if (attr == MP_QSTR_q)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->q);
+                return;
+            }
+            else if (attr == MP_QSTR_G)
+            {
+                mp_point_t *pr = new_point_init_shared(self->ecc_curve);
+                dest[0] = pr;
+                return;
+            }
+            else if (attr == MP_QSTR_gx)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->g->x);
+                return;
+            }
+            else if (attr == MP_QSTR_gy)
+            {
+                dest[0] = mp_obj_new_int_from_fp(self->ecc_curve->g->y);
+                return;
+            }
+            else if (attr == MP_QSTR_name)
+            {
+                dest[0] = mp_obj_new_str_of_type(&mp_type_str, (const byte *)vstr_str(&self->ecc_curve->name), vstr_len(&self->ecc_curve->name));
+                return;
+            }
+            else if (attr == MP_QSTR_oid)
+            {
+                dest[0] = mp_obj_new_str_of_type(&mp_type_bytes, (const byte *)vstr_str(&self->ecc_curve->oid), vstr_len(&self->ecc_curve->oid));
+                return;
+            }
+            else if (attr == MP_QSTR_complete)
+            {
+                dest[0] = mp_obj_new_bool(self->ecc_curve->complete != NULL);
+                return;
+            }
+            mp_convert_member_lookup(obj, type, elem->value, dest);
+        }
+    }
+    else
+    {
+        if ((attr == MP_QSTR_p || attr == MP_QSTR_a || attr == MP_QSTR_b || attr == MP_QSTR_q || attr == MP_QSTR_gx || attr == MP_QSTR_gy) && !MP_OBJ_IS_INT(dest[1]))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT, mp_obj_get_type_str(dest[1]));
+        }
+        else if (attr == MP_QSTR_G && !MP_OBJ_IS_TYPE(dest[1], &point_type))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_BUT, mp_obj_get_type_str(dest[1]));
+        }
+        else if ((attr == MP_QSTR_name || attr == MP_QSTR_oid) && !MP_OBJ_IS_STR_OR_BYTES(dest[1]))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(dest[1]));
+        }
+
+        // points share the curve and see no change, it goes to a copy (of the curve of the new G)
+        ecc_curve_t *curve = ec_curve_copy((attr == MP_QSTR_G) ? ((mp_point_t *)MP_OBJ_TO_PTR(dest[1]))->ecc_curve : self->ecc_curve);
+
+        if (attr == MP_QSTR_p)
+        {
+            mp_fp_for_int(dest[1], curve->p);
+            ec_curve_field_setup(curve);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_a)
+        {
+            mp_fp_for_int(dest[1], curve->a);
+            ec_curve_field_setup(curve);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_b)
+        {
+            mp_fp_for_int(dest[1], curve->b);
+            ec_curve_field_setup(curve);
+        }
+        else if (attr == MP_QSTR_q)
+        {
+            mp_fp_for_int(dest[1], curve->q);
+            ec_curve_glv_setup(curve);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_G)
+        {
+            mp_point_t *other = MP_OBJ_TO_PTR(dest[1]);
+
+            fp_copy(other->ecc_point->x, curve->g->x);
+            fp_copy(other->ecc_point->y, curve->g->y);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_gx)
+        {
+            mp_fp_for_int(dest[1], curve->g->x);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_gy)
+        {
+            mp_fp_for_int(dest[1], curve->g->y);
+            curve->gtable = ec_generator_table_new();
+        }
+        else if (attr == MP_QSTR_name)
+        {
+            mp_buffer_info_t bufinfo_name;
+            mp_get_buffer_raise(dest[1], &bufinfo_name, MP_BUFFER_READ);
+            vstr_init(&curve->name, bufinfo_name.len);
+            vstr_add_strn(&curve->name, bufinfo_name.buf, bufinfo_name.len);
+        }
+        else if (attr == MP_QSTR_oid)
+        {
+            mp_buffer_info_t bufinfo_oid;
+            mp_get_buffer_raise(dest[1], &bufinfo_oid, MP_BUFFER_READ);
+
+            if (MP_OBJ_IS_TYPE(dest[1], &mp_type_bytes))
+            {
+                vstr_init(&curve->oid, bufinfo_oid.len);
+                vstr_add_strn(&curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
+            }
+            else if (MP_OBJ_IS_STR(dest[1]))
+            {
+                vstr_unhexlify(&curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
+            }
+        }
+        else if (attr == MP_QSTR_complete)
+        {
+            curve->complete = mp_obj_is_true(dest[1]) ? &ec_complete_generic : NULL;
+            ec_curve_field_setup(curve);
+        }
+        else
+        {
+            return;
+        }
+        // the formulas are complete, and the ladder right, on prime order curves only
+        if (curve->complete != NULL && !ec_curve_cofactor_is_one(curve))
+        {
+            mp_raise_ValueError(ERROR_CURVE_COMPLETE_COFACTOR);
+        }
+
+        // the changed curve is shared like a new one
+        curve->hash = ec_curve_hash(curve);
+        ecc_curve_t *interned = ec_curve_registry_lookup(curve);
+        if (interned == NULL)
+        {
+            ec_curve_registry_add(curve);
+            interned = curve;
+        }
+        self->ecc_curve = interned;
+        dest[0] = MP_OBJ_NULL; // indicate success
+    }
+}
+
+// named curves of Curve.from_oid, the ones of ufastecdsa.curve
+typedef struct _ecc_named_curve_t
+{
+    const char *name;
+    const char *oid;
+    size_t oid_len;
+    const char *p, *a, *b, *q, *gx, *gy;
+} ecc_named_curve_t;
+
+static const ecc_named_curve_t ecc_named_curves[] = {
+    {
+        "P256",
+        "\x2A\x86\x48\xCE\x3D\x03\x01\x07", 8,
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFF",
+        "FFFFFFFF00000001000000000000000000000000FFFFFFFFFFFFFFFFFFFFFFFC",
+        "5AC635D8AA3A93E7B3EBBD55769886BC651D06B0CC53B0F63BCE3C3E27D2604B",
+        "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551",
+        "6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296",
+        "4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5",
+    },
+    {
+        "P384",
+        "\x2B\x81\x04\x00\x22", 5,
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFC",
+        "B3312FA7E23EE7E4988E056BE3F82D19181D9C6EFE8141120314088F5013875AC656398D8A2ED19D2A85C8EDD3EC2AEF",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC7634D81F4372DDF581A0DB248B0A77AECEC196ACCC52973",
+        "AA87CA22BE8B05378EB1C71EF320AD746E1D3B628BA79B9859F741E082542A385502F25DBF55296C3A545E3872760AB7",
+        "3617DE4A96262C6F5D9E98BF9292DC29F8F41DBD289A147CE9DA3113B5F0B8C00A60B1CE1D7E819D7A431D7C90EA0E5F",
+    },
+    {
+        "P521",
+        "\x2B\x81\x04\x00\x23", 5,
+        "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF",
+        "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC",
+        "51953EB9618E1C9A1F929A21A0B68540EEA2DA725B99B315F3B8B489918EF109E156193951EC7E937B1652C0BD3BB1BF073573DF883D2C34F1EF451FD46B503F00",
+        "1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFA51868783BF2F966B7FCC0148F709A5D03BB5C9B8899C47AEBB6FB71E91386409",
+        "C6858E06B70404E9CD9E3ECB662395B4429C648139053FB521F828AF606B4D3DBAA14B5E77EFE75928FE1DC127A2FFA8DE3348B3C1856A429BF97E7E31C2E5BD66",
+        "11839296A789A3BC0045C8A5FB42C7D1BD998F54449579B446817AFBD17273E662C97EE72995EF42640C550B9013FAD0761353C7086A272C24088BE94769FD16650",
+    },
+    {
+        "SECP256K1",
+        "\x2B\x81\x04\x00\x0A", 5,
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F",
+        "0",
+        "7",
+        "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141",
+        "79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798",
+        "483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8",
+    },
+};
+
+static mp_obj_t curve_from_oid(mp_obj_t oid)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_STR_OR_BYTES(oid))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(oid));
+    }
+
+    mp_buffer_info_t bufinfo_oid;
+    mp_get_buffer_raise(oid, &bufinfo_oid, MP_BUFFER_READ);
+
+    vstr_t vstr_oid;
+    if (MP_OBJ_IS_TYPE(oid, &mp_type_bytes))
+    {
+        vstr_init(&vstr_oid, bufinfo_oid.len);
+        vstr_add_strn(&vstr_oid, bufinfo_oid.buf, bufinfo_oid.len);
+    }
+    else
+    {
+        vstr_unhexlify(&vstr_oid, bufinfo_oid.buf, bufinfo_oid.len);
+    }
+
+    for (size_t i = 0; i < MP_ARRAY_SIZE(ecc_named_curves); i++)
+    {
+        const ecc_named_curve_t *named = &ecc_named_curves[i];
+        if (named->oid_len == vstr_len(&vstr_oid) && memcmp(named->oid, vstr_str(&vstr_oid), named->oid_len) == 0)
+        {
+            ecc_curve_t *curve = ec_curve_alloc();
+            fp_read_radix(curve->p, named->p, 16);
+            fp_read_radix(curve->a, named->a, 16);
+            fp_read_radix(curve->b, named->b, 16);
+            fp_read_radix(curve->q, named->q, 16);
+            fp_read_radix(curve->g->x, named->gx, 16);
+            fp_read_radix(curve->g->y, named->gy, 16);
+            vstr_add_str(&curve->name, named->name);
+            vstr_add_strn(&curve->oid, named->oid, named->oid_len);
+            curve->complete = NULL;
+
+            vstr_clear(&vstr_oid);
+            return MP_OBJ_FROM_PTR(new_curve_init_shared(ec_curve_intern(curve)));
+        }
+    }
+    vstr_clear(&vstr_oid);
+    mp_raise_ValueError(ERROR_CURVE_OID_NOT_FOUND);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_1(curve_from_oid_obj, curve_from_oid);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_curve_from_oid_obj, MP_ROM_PTR(&curve_from_oid_obj));
+
+static const mp_rom_map_elem_t curve_locals_dict_table[] = {
+    {MP_ROM_QSTR(MP_QSTR_from_oid), MP_ROM_PTR(&static_curve_from_oid_obj)},
+    {MP_ROM_QSTR(MP_QSTR_p), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_a), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_b), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_q), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_G), MP_ROM_PTR(mp_const_none)},
+    {MP_ROM_QSTR(MP_QSTR_gx), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_gy), MP_ROM_INT(0)},
+    {MP_ROM_QSTR(MP_QSTR_name), MP_ROM_PTR(mp_const_none)},
+    {MP_ROM_QSTR(MP_QSTR_oid), MP_ROM_PTR(mp_const_none)},
+    {MP_ROM_QSTR(MP_QSTR_complete), MP_ROM_FALSE},
+};
+
+static MP_DEFINE_CONST_DICT(curve_locals_dict, curve_locals_dict_table);
+
+static mp_obj_t curve_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    curve_type,
+    MP_QSTR_Curve,
+    MP_TYPE_FLAG_NONE,
+    make_new, curve_make_new,
+    print, curve_print,
+    binary_op, curve_binary_op,
+    attr, curve_attr,
+    locals_dict, &curve_locals_dict);
+
+static mp_obj_t curve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    /*
+        Currently only curves in Weierstrass form (y^2 = x^3 + ax + b (mod p))
+
+        p (int): The value of math p in the curve equation
+        a (int): The value of math a in the curve equation
+        b (int): The value of math b in the curve equation
+        q (int): The order of the base point of the curve
+        gx (int): The x coordinate of the base point of the curve
+        gy (int): The y coordinate of the base point of the curve
+        name (str): The name of the curve
+        oid (str/bytes): The object identifier of the curve
+        complete (bool): Multiply points with the complete formulas, without branches on the scalar,
+                         only on curves of prime order q
+    */
+
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_p, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_a, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_b, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_q, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_gx, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_gy, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_name, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_oid, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_complete, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false}},
+    };
+
+    struct
+    {
+        mp_arg_val_t p, a, b, q, gx, gy, name, oid, complete;
+    } args;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    mp_curve_t *curve = m_new_obj(mp_curve_t);
+    curve->base.type = &curve_type;
+    curve->ecc_curve = ec_curve_alloc();
+    for (size_t i = 0; i < n_args; i++)
+    {
+        if (!MP_OBJ_IS_INT(pos_args[i]))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, mp_obj_get_type_str(pos_args[i]), i);
+        }
+    }
+
+    mp_fp_for_int(args.p.u_obj, curve->ecc_curve->p);
+    mp_fp_for_int(args.a.u_obj, curve->ecc_curve->a);
+    mp_fp_for_int(args.b.u_obj, curve->ecc_curve->b);
+    mp_fp_for_int(args.q.u_obj, curve->ecc_curve->q);
+    mp_fp_for_int(args.gx.u_obj, curve->ecc_curve->g->x);
+    mp_fp_for_int(args.gy.u_obj, curve->ecc_curve->g->y);
+
+    if (args.name.u_obj != mp_const_none)
+    {
+        if (!MP_OBJ_IS_STR_OR_BYTES(args.name.u_obj))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(args.name.u_obj));
+        }
+        else
+        {
+            mp_buffer_info_t bufinfo_name;
+            mp_get_buffer_raise(args.name.u_obj, &bufinfo_name, MP_BUFFER_READ);
+            vstr_add_strn(&curve->ecc_curve->name, bufinfo_name.buf, bufinfo_name.len);
+        }
+    }
+
+    if (args.oid.u_obj != mp_const_none)
+    {
+        if (!MP_OBJ_IS_STR_OR_BYTES(args.oid.u_obj))
+        {
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(args.oid.u_obj));
+        }
+        else
+        {
+            mp_buffer_info_t bufinfo_oid;
+            mp_get_buffer_raise(args.oid.u_obj, &bufinfo_oid, MP_BUFFER_READ);
+
+            if (MP_OBJ_IS_TYPE(args.oid.u_obj, &mp_type_bytes))
+            {
+                vstr_init(&curve->ecc_curve->oid, bufinfo_oid.len);
+                vstr_add_strn(&curve->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
+            }
+            else if (MP_OBJ_IS_STR(args.oid.u_obj))
+            {
+                vstr_unhexlify(&curve->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
+            }
+        }
+    }
+
+    curve->ecc_curve->complete = args.complete.u_bool ? &ec_complete_generic : NULL;
+    if (curve->ecc_curve->complete != NULL && !ec_curve_cofactor_is_one(curve->ecc_curve))
+    {
+        mp_raise_ValueError(ERROR_CURVE_COMPLETE_COFACTOR);
+    }
+    curve->ecc_curve = ec_curve_intern(curve->ecc_curve);
+
+    return MP_OBJ_FROM_PTR(curve);
+}
+
+// ECC.Curve is the type itself, so that ECC.Curve.from_oid is reachable
+static mp_obj_t curve_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args)
+{
+    fp_scratch_enter();
+
+    (void)type;
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+    return curve(n_args, args, &kw_args);
+}
+
+///////////////////////////////////// Point ////////////////////////////////////
+
+static bool ec_point_equal(ecc_point_t *p1, ecc_point_t *p2)
+{
+    // check x coords
+    if (fp_cmp(p1->x, p2->x) != FP_EQ)
+    {
+        return false;
+    }
+    // check y coords
+    if (fp_cmp(p1->y, p2->y) != FP_EQ)
+    {
+        return false;
+    }
+    return true;
+}
+
+static void ec_point_double(ecc_point_t *rop, ecc_point_t *op, ecc_curve_t *curve)
+{
+    if (fp_cmp_d(op->x, 0) == FP_EQ && fp_cmp_d(op->y, 0) == FP_EQ)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+
+    fp_int *numer = fp_alloc_scratch();
+    fp_int *denom = fp_alloc_scratch();
+    fp_int *lambda = fp_alloc_scratch();
+
+    // calculate lambda
+    fp_mul(op->x, op->x, numer);
+    fp_mul_d(numer, 3, numer);
+    fp_add(numer, curve->a, numer);
+    fp_mul_d(op->y, 2, denom);
+
+    // handle 2P = identity case
+    if (fp_invmod(denom, curve->p, denom) != FP_OKAY)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+
+        fp_free(numer);
+        fp_free(denom);
+        fp_free(lambda);
+        return;
+    }
+
+    fp_mul(numer, denom, lambda);
+    fp_mod(lambda, curve->p, lambda);
+
+    // calculate resulting x coord
+    fp_mul(lambda, lambda, rop->x);
+    fp_sub(rop->x, op->x, rop->x);
+    fp_sub(rop->x, op->x, rop->x);
+    fp_mod(rop->x, curve->p, rop->x);
+
+    // calculate resulting y coord
+    fp_sub(op->x, rop->x, rop->y);
+    fp_mul(lambda, rop->y, rop->y);
+    fp_sub(rop->y, op->y, rop->y);
+    fp_mod(rop->y, curve->p, rop->y);
+
+    fp_free(numer);
+    fp_free(denom);
+    fp_free(lambda);
+}
+
+static void ec_point_add(ecc_point_t *rop, ecc_point_t *op1, ecc_point_t *op2, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (fp_cmp_d(op1->x, 0) == FP_EQ && fp_cmp_d(op1->y, 0) == FP_EQ && fp_cmp_d(op2->x, 0) == FP_EQ && fp_cmp_d(op2->y, 0) == FP_EQ)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+    else if (fp_cmp_d(op1->x, 0) == FP_EQ && fp_cmp_d(op1->y, 0) == FP_EQ)
+    {
+        fp_copy(op2->x, rop->x);
+        fp_copy(op2->y, rop->y);
+        return;
+    }
+    else if (fp_cmp_d(op2->x, 0) == FP_EQ && fp_cmp_d(op2->y, 0) == FP_EQ)
+    {
+        fp_copy(op1->x, rop->x);
+        fp_copy(op1->y, rop->y);
+        return;
+    }
+
+    if (ec_point_equal(op1, op2))
+    {
+        ec_point_double(rop, op1, curve);
+        return;
+    }
+
+    // check if points sum to identity element
+    fp_int *negy = fp_alloc_scratch();
+
+    fp_sub(curve->p, op2->y, negy);
+    if (fp_cmp(op1->x, op2->x) == FP_EQ && fp_cmp(op1->y, negy) == 0)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+
+        fp_free(negy);
+        return;
+    }
+
+    fp_int *xdiff = fp_alloc_scratch();
+    fp_int *ydiff = fp_alloc_scratch();
+    fp_int *lambda = fp_alloc_scratch();
+
+    // calculate lambda
+    fp_sub(op2->y, op1->y, ydiff);
+    fp_sub(op2->x, op1->x, xdiff);
+    fp_invmod(xdiff, curve->p, xdiff);
+    fp_mul(ydiff, xdiff, lambda);
+    fp_mod(lambda, curve->p, lambda);
+
+    // calculate resulting x coord
+    fp_mul(lambda, lambda, rop->x);
+    fp_sub(rop->x, op1->x, rop->x);
+    fp_sub(rop->x, op2->x, rop->x);
+    fp_mod(rop->x, curve->p, rop->x);
+
+    // calculate resulting y coord
+    fp_sub(op1->x, rop->x, rop->y);
+    fp_mul(lambda, rop->y, rop->y);
+    fp_sub(rop->y, op1->y, rop->y);
+    fp_mod(rop->y, curve->p, rop->y);
+
+    fp_free(xdiff);
+    fp_free(ydiff);
+    fp_free(lambda);
+    fp_free(negy);
+}
+
+static void ec_jacobian_set_identity(ecc_jacobian_point_t *rop, ecc_curve_t *curve)
+{
+    ec_fe_zero(&rop->x, curve);
+    ec_fe_zero(&rop->y, curve);
+    ec_fe_zero(&rop->z, curve);
+    rop->x.dp[0] = 1;
+    rop->y.dp[0] = 1;
+}
+
+// converts to jacobian coordinates and enters the montgomery domain
+static void ec_point_to_jacobian(ecc_jacobian_point_t *rop, ecc_point_t *op, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (fp_cmp_d(op->x, 0) == FP_EQ && fp_cmp_d(op->y, 0) == FP_EQ)
+    {
+        ec_jacobian_set_identity(rop, curve);
+        return;
+    }
+
+    fp_int *t = fp_alloc_scratch();
+    fp_mod(op->x, curve->p, t);
+    ec_fe_from_fp(&rop->x, t, curve);
+    fp_mod(op->y, curve->p, t);
+    ec_fe_from_fp(&rop->y, t, curve);
+    fp_free(t);
+
+    ec_fe_to_montgomery(&rop->x, &rop->x, curve);
+    ec_fe_to_montgomery(&rop->y, &rop->y, curve);
+    rop->z = curve->one;
+}
+
+// rop = (x, y) leaving the montgomery domain
+static void ec_fe_to_affine(ecc_point_t *rop, ec_fe_t *x, ec_fe_t *y, ecc_curve_t *curve)
+{
+    ec_fe_t t;
+    ec_fe_from_montgomery(&t, x, curve);
+    ec_fe_to_fp(rop->x, &t, curve);
+    ec_fe_from_montgomery(&t, y, curve);
+    ec_fe_to_fp(rop->y, &t, curve);
+}
+
+// converts to affine coordinates and leaves the montgomery domain
+static void ec_jacobian_to_affine(ecc_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (ec_fe_iszero(&op->z, curve))
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+
+    ec_fe_t zinv, zinv2, x, y;
+
+    // x = X / Z^2, y = Y / Z^3
+    ec_fe_invert(&zinv, &op->z, curve);
+    ec_fe_sqr(&zinv2, &zinv, curve);
+    ec_fe_mul(&x, &op->x, &zinv2, curve);
+    ec_fe_mul(&zinv2, &zinv2, &zinv, curve);
+    ec_fe_mul(&y, &op->y, &zinv2, curve);
+    ec_fe_to_affine(rop, &x, &y, curve);
+}
+
+// rop[i] = op[i] in affine coordinates for all i < n sharing a single inversion
+static void ec_jacobian_to_affine_batch(ecc_point_t **rop, ecc_jacobian_point_t **op, size_t n, ecc_curve_t *curve)
+{
+    fp_int **zinv = m_new(fp_int *, n);
+    ec_fe_t z, zinv2, x, y;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        zinv[i] = fp_alloc();
+        ec_fe_from_montgomery(&z, &op[i]->z, curve);
+        ec_fe_to_fp(zinv[i], &z, curve);
+    }
+
+    if (fp_invmod_batch(zinv, zinv, n, curve->p) != FP_OKAY)
+    {
+        // p is not prime, convert one by one
+        for (size_t i = 0; i < n; i++)
+        {
+            ec_jacobian_to_affine(rop[i], op[i], curve);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            // handle the identity element
+            if (fp_iszero(zinv[i]) == FP_YES)
+            {
+                fp_set(rop[i]->x, 0);
+                fp_set(rop[i]->y, 0);
+                continue;
+            }
+
+            // x = X / Z^2, y = Y / Z^3
+            ec_fe_from_fp(&z, zinv[i], curve);
+            ec_fe_to_montgomery(&z, &z, curve);
+            ec_fe_sqr(&zinv2, &z, curve);
+            ec_fe_mul(&x, &op[i]->x, &zinv2, curve);
+            ec_fe_mul(&zinv2, &zinv2, &z, curve);
+            ec_fe_mul(&y, &op[i]->y, &zinv2, curve);
+            ec_fe_to_affine(rop[i], &x, &y, curve);
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        fp_free(zinv[i]);
+    }
+    m_del(fp_int *, zinv, n);
+}
+
+
+// rop = 2 * op for any a (dbl-2007-bl with M = 3 * XX + a * ZZ^2), 3M + 6S and a multiplication by a
+static void ec_jacobian_double_generic(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    // handle the identity element and 2P = identity case
+    if (ec_fe_iszero(&op->z, curve) || ec_fe_iszero(&op->y, curve))
+    {
+        ec_jacobian_set_identity(rop, curve);
+        return;
+    }
+
+    ec_fe_t xx, yy, zz, s, m;
+
+    // XX = X^2, YY = Y^2, ZZ = Z^2
+    ec_fe_sqr(&xx, &op->x, curve);
+    ec_fe_sqr(&yy, &op->y, curve);
+    ec_fe_sqr(&zz, &op->z, curve);
+
+    // S = 4 * X * YY
+    ec_fe_mul(&s, &op->x, &yy, curve);
+    ec_fe_add(&s, &s, &s, curve);
+    ec_fe_add(&s, &s, &s, curve);
+
+    // M = 3 * XX + a * ZZ^2
+    ec_fe_sqr(&zz, &zz, curve);
+    ec_fe_mul(&m, &curve->am, &zz, curve);
+    ec_fe_add(&m, &m, &xx, curve);
+    ec_fe_add(&xx, &xx, &xx, curve);
+    ec_fe_add(&m, &m, &xx, curve);
+
+    // Z3 = 2 * Y * Z
+    ec_fe_mul(&rop->z, &op->y, &op->z, curve);
+    ec_fe_add(&rop->z, &rop->z, &rop->z, curve);
+
+    // X3 = M^2 - 2 * S
+    ec_fe_sqr(&rop->x, &m, curve);
+    ec_fe_sub(&rop->x, &rop->x, &s, curve);
+    ec_fe_sub(&rop->x, &rop->x, &s, curve);
+
+    // Y3 = M * (S - X3) - 8 * YY^2
+    ec_fe_sqr(&yy, &yy, curve);
+    ec_fe_add(&yy, &yy, &yy, curve);
+    ec_fe_add(&yy, &yy, &yy, curve);
+    ec_fe_add(&yy, &yy, &yy, curve);
+    ec_fe_sub(&s, &s, &rop->x, curve);
+    ec_fe_mul(&rop->y, &m, &s, curve);
+    ec_fe_sub(&rop->y, &rop->y, &yy, curve);
+}
+
+// rop = 2 * op for a = -3 (dbl-2001-b with M = 3 * (X - ZZ) * (X + ZZ)), 3M + 5S
+static void ec_jacobian_double_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    // handle the identity element and 2P = identity case
+    if (ec_fe_iszero(&op->z, curve) || ec_fe_iszero(&op->y, curve))
+    {
+        ec_jacobian_set_identity(rop, curve);
+        return;
+    }
+
+    ec_fe_t delta, gamma, beta, alpha, t;
+
+    // delta = Z^2, gamma = Y^2, beta = X * gamma
+    ec_fe_sqr(&delta, &op->z, curve);
+    ec_fe_sqr(&gamma, &op->y, curve);
+    ec_fe_mul(&beta, &op->x, &gamma, curve);
+
+    // alpha = 3 * (X - delta) * (X + delta)
+    ec_fe_sub(&t, &op->x, &delta, curve);
+    ec_fe_add(&alpha, &op->x, &delta, curve);
+    ec_fe_mul(&alpha, &alpha, &t, curve);
+    ec_fe_add(&t, &alpha, &alpha, curve);
+    ec_fe_add(&alpha, &alpha, &t, curve);
+
+    // Z3 = (Y + Z)^2 - gamma - delta
+    ec_fe_add(&t, &op->y, &op->z, curve);
+    ec_fe_sqr(&rop->z, &t, curve);
+    ec_fe_sub(&rop->z, &rop->z, &gamma, curve);
+    ec_fe_sub(&rop->z, &rop->z, &delta, curve);
+
+    // X3 = alpha^2 - 8 * beta
+    ec_fe_add(&beta, &beta, &beta, curve);
+    ec_fe_add(&beta, &beta, &beta, curve);
+    ec_fe_add(&t, &beta, &beta, curve);
+    ec_fe_sqr(&rop->x, &alpha, curve);
+    ec_fe_sub(&rop->x, &rop->x, &t, curve);
+
+    // Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+    ec_fe_sub(&beta, &beta, &rop->x, curve);
+    ec_fe_mul(&rop->y, &alpha, &beta, curve);
+    ec_fe_sqr(&gamma, &gamma, curve);
+    ec_fe_add(&gamma, &gamma, &gamma, curve);
+    ec_fe_add(&gamma, &gamma, &gamma, curve);
+    ec_fe_add(&gamma, &gamma, &gamma, curve);
+    ec_fe_sub(&rop->y, &rop->y, &gamma, curve);
+}
+
+// doubling selected for the curve when its domain was set up
+static void ec_jacobian_double(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    curve->dbl(rop, op, curve);
+}
+
+static void ec_jacobian_add(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (ec_fe_iszero(&op1->z, curve))
+    {
+        *rop = *op2;
+        return;
+    }
+    else if (ec_fe_iszero(&op2->z, curve))
+    {
+        *rop = *op1;
+        return;
+    }
+
+    ec_fe_t z1z1, z2z2, u1, u2, s1, s2;
+
+    // U1 = X1 * Z2^2, U2 = X2 * Z1^2
+    ec_fe_sqr(&z1z1, &op1->z, curve);
+    ec_fe_sqr(&z2z2, &op2->z, curve);
+    ec_fe_mul(&u1, &op1->x, &z2z2, curve);
+    ec_fe_mul(&u2, &op2->x, &z1z1, curve);
+
+    // S1 = Y1 * Z2^3, S2 = Y2 * Z1^3
+    ec_fe_mul(&s1, &op1->y, &op2->z, curve);
+    ec_fe_mul(&s1, &s1, &z2z2, curve);
+    ec_fe_mul(&s2, &op2->y, &op1->z, curve);
+    ec_fe_mul(&s2, &s2, &z1z1, curve);
+
+    // H = U2 - U1, R = S2 - S1
+    ec_fe_sub(&u2, &u2, &u1, curve);
+    ec_fe_sub(&s2, &s2, &s1, curve);
+
+    if (ec_fe_iszero(&u2, curve))
+    {
+        // same x: either the same point or points sum to identity element
+        if (ec_fe_iszero(&s2, curve))
+        {
+            ec_jacobian_double(rop, op1, curve);
+        }
+        else
+        {
+            ec_jacobian_set_identity(rop, curve);
+        }
+    }
+    else
+    {
+        // Z3 = Z1 * Z2 * H
+        ec_fe_mul(&rop->z, &op1->z, &op2->z, curve);
+        ec_fe_mul(&rop->z, &rop->z, &u2, curve);
+
+        // HH = H^2, HHH = H * HH, V = U1 * HH
+        ec_fe_sqr(&z1z1, &u2, curve);
+        ec_fe_mul(&z2z2, &u2, &z1z1, curve);
+        ec_fe_mul(&u1, &u1, &z1z1, curve);
+
+        // X3 = R^2 - HHH - 2 * V
+        ec_fe_sqr(&rop->x, &s2, curve);
+        ec_fe_sub(&rop->x, &rop->x, &z2z2, curve);
+        ec_fe_sub(&rop->x, &rop->x, &u1, curve);
+        ec_fe_sub(&rop->x, &rop->x, &u1, curve);
+
+        // Y3 = R * (V - X3) - S1 * HHH
+        ec_fe_sub(&u1, &u1, &rop->x, curve);
+        ec_fe_mul(&rop->y, &s2, &u1, curve);
+        ec_fe_mul(&s1, &s1, &z2z2, curve);
+        ec_fe_sub(&rop->y, &rop->y, &s1, curve);
+    }
+}
+
+// rop = op1 + op2 for an affine op2, Z2 = 1 in the domain, or the identity element (madd-2004-hmv):
+// skipping the products by Z2 saves 4 multiplications and a squaring over ec_jacobian_add
+static void ec_jacobian_add_mixed(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (ec_fe_iszero(&op1->z, curve))
+    {
+        *rop = *op2;
+        return;
+    }
+    else if (ec_fe_iszero(&op2->z, curve))
+    {
+        *rop = *op1;
+        return;
+    }
+
+    ec_fe_t z1z1, u2, s2, hhh, v;
+
+    // U2 = X2 * Z1^2, S2 = Y2 * Z1^3
+    ec_fe_sqr(&z1z1, &op1->z, curve);
+    ec_fe_mul(&u2, &op2->x, &z1z1, curve);
+    ec_fe_mul(&s2, &op2->y, &op1->z, curve);
+    ec_fe_mul(&s2, &s2, &z1z1, curve);
+
+    // H = U2 - X1, R = S2 - Y1
+    ec_fe_sub(&u2, &u2, &op1->x, curve);
+    ec_fe_sub(&s2, &s2, &op1->y, curve);
+
+    if (ec_fe_iszero(&u2, curve))
+    {
+        // same x: either the same point or points sum to identity element
+        if (ec_fe_iszero(&s2, curve))
+        {
+            ec_jacobian_double(rop, op1, curve);
+        }
+        else
+        {
+            ec_jacobian_set_identity(rop, curve);
+        }
+    }
+    else
+    {
+        // HH = H^2, HHH = H * HH, V = X1 * HH, Z3 = Z1 * H
+        ec_fe_sqr(&z1z1, &u2, curve);
+        ec_fe_mul(&hhh, &u2, &z1z1, curve);
+        ec_fe_mul(&v, &op1->x, &z1z1, curve);
+        ec_fe_mul(&rop->z, &op1->z, &u2, curve);
+
+        // Y1 * HHH, before rop overwrites op1
+        ec_fe_mul(&z1z1, &op1->y, &hhh, curve);
+
+        // X3 = R^2 - HHH - 2 * V
+        ec_fe_sqr(&rop->x, &s2, curve);
+        ec_fe_sub(&rop->x, &rop->x, &hhh, curve);
+        ec_fe_sub(&rop->x, &rop->x, &v, curve);
+        ec_fe_sub(&rop->x, &rop->x, &v, curve);
+
+        // Y3 = R * (V - X3) - Y1 * HHH
+        ec_fe_sub(&v, &v, &rop->x, curve);
+        ec_fe_mul(&rop->y, &s2, &v, curve);
+        ec_fe_sub(&rop->y, &rop->y, &z1z1, curve);
+    }
+}
+
+// a = b if mask is all ones, a unchanged if mask is zero, without branching on mask or on the values,
+// a and b have at most limbs digits
+static void ec_fe_cmov(ec_fe_t *a, ec_fe_t *b, fp_digit mask, size_t limbs)
+{
+    for (size_t i = 0; i < limbs; i++)
+    {
+        a->dp[i] ^= (a->dp[i] ^ b->dp[i]) & mask;
+    }
+}
+
+static void ec_jacobian_cmov(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, fp_digit mask, size_t limbs)
+{
+    ec_fe_cmov(&rop->x, &op->x, mask, limbs);
+    ec_fe_cmov(&rop->y, &op->y, mask, limbs);
+    ec_fe_cmov(&rop->z, &op->z, mask, limbs);
+}
+
+// swaps a and b if mask is all ones, without branching on mask or on the values, a and b have at most limbs digits
+static void ec_fe_cswap(ec_fe_t *a, ec_fe_t *b, fp_digit mask, size_t limbs)
+{
+    for (size_t i = 0; i < limbs; i++)
+    {
+        fp_digit t = (a->dp[i] ^ b->dp[i]) & mask;
+        a->dp[i] ^= t;
+        b->dp[i] ^= t;
+    }
+}
+
+// rop = op1 + op2 in projective coordinates for any a (Renes, Costello, Batina, algorithm 1), 12M + 2 * 3b + 3 * a
+static void ec_complete_add(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve)
+{
+    ec_fe_t t0, t1, t2, t3, t4, t5, x3, y3, z3;
+
+    ec_fe_mul(&t0, &op1->x, &op2->x, curve);
+    ec_fe_mul(&t1, &op1->y, &op2->y, curve);
+    ec_fe_mul(&t2, &op1->z, &op2->z, curve);
+    ec_fe_add(&t3, &op1->x, &op1->y, curve);
+    ec_fe_add(&t4, &op2->x, &op2->y, curve);
+    ec_fe_mul(&t3, &t3, &t4, curve);
+    ec_fe_add(&t4, &t0, &t1, curve);
+    ec_fe_sub(&t3, &t3, &t4, curve);
+    ec_fe_add(&t4, &op1->x, &op1->z, curve);
+    ec_fe_add(&t5, &op2->x, &op2->z, curve);
+    ec_fe_mul(&t4, &t4, &t5, curve);
+    ec_fe_add(&t5, &t0, &t2, curve);
+    ec_fe_sub(&t4, &t4, &t5, curve);
+    ec_fe_add(&t5, &op1->y, &op1->z, curve);
+    ec_fe_add(&x3, &op2->y, &op2->z, curve);
+    ec_fe_mul(&t5, &t5, &x3, curve);
+    ec_fe_add(&x3, &t1, &t2, curve);
+    ec_fe_sub(&t5, &t5, &x3, curve);
+    ec_fe_mul(&z3, &curve->am, &t4, curve);
+    ec_fe_mul(&x3, &curve->b3m, &t2, curve);
+    ec_fe_add(&z3, &x3, &z3, curve);
+    ec_fe_sub(&x3, &t1, &z3, curve);
+    ec_fe_add(&z3, &t1, &z3, curve);
+    ec_fe_mul(&y3, &x3, &z3, curve);
+    ec_fe_add(&t1, &t0, &t0, curve);
+    ec_fe_add(&t1, &t1, &t0, curve);
+    ec_fe_mul(&t2, &curve->am, &t2, curve);
+    ec_fe_mul(&t4, &curve->b3m, &t4, curve);
+    ec_fe_add(&t1, &t1, &t2, curve);
+    ec_fe_sub(&t2, &t0, &t2, curve);
+    ec_fe_mul(&t2, &curve->am, &t2, curve);
+    ec_fe_add(&t4, &t4, &t2, curve);
+    ec_fe_mul(&t0, &t1, &t4, curve);
+    ec_fe_add(&y3, &y3, &t0, curve);
+    ec_fe_mul(&t0, &t5, &t4, curve);
+    ec_fe_mul(&x3, &x3, &t3, curve);
+    ec_fe_sub(&x3, &x3, &t0, curve);
+    ec_fe_mul(&t0, &t3, &t1, curve);
+    ec_fe_mul(&z3, &z3, &t5, curve);
+    ec_fe_add(&z3, &z3, &t0, curve);
+
+    rop->x = x3;
+    rop->y = y3;
+    rop->z = z3;
+}
+
+// rop = 2 * op in projective coordinates for any a (algorithm 3), 8M + 3S + 2 * 3b + 3 * a
+static void ec_complete_double(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    ec_fe_t t0, t1, t2, t3, x3, y3, z3;
+
+    ec_fe_sqr(&t0, &op->x, curve);
+    ec_fe_sqr(&t1, &op->y, curve);
+    ec_fe_sqr(&t2, &op->z, curve);
+    ec_fe_mul(&t3, &op->x, &op->y, curve);
+    ec_fe_add(&t3, &t3, &t3, curve);
+    ec_fe_mul(&z3, &op->x, &op->z, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+    ec_fe_mul(&x3, &curve->am, &z3, curve);
+    ec_fe_mul(&y3, &curve->b3m, &t2, curve);
+    ec_fe_add(&y3, &x3, &y3, curve);
+    ec_fe_sub(&x3, &t1, &y3, curve);
+    ec_fe_add(&y3, &t1, &y3, curve);
+    ec_fe_mul(&y3, &x3, &y3, curve);
+    ec_fe_mul(&x3, &t3, &x3, curve);
+    ec_fe_mul(&z3, &curve->b3m, &z3, curve);
+    ec_fe_mul(&t2, &curve->am, &t2, curve);
+    ec_fe_sub(&t3, &t0, &t2, curve);
+    ec_fe_mul(&t3, &curve->am, &t3, curve);
+    ec_fe_add(&t3, &t3, &z3, curve);
+    ec_fe_add(&z3, &t0, &t0, curve);
+    ec_fe_add(&t0, &z3, &t0, curve);
+    ec_fe_add(&t0, &t0, &t2, curve);
+    ec_fe_mul(&t0, &t0, &t3, curve);
+    ec_fe_add(&y3, &y3, &t0, curve);
+    ec_fe_mul(&t2, &op->y, &op->z, curve);
+    ec_fe_add(&t2, &t2, &t2, curve);
+    ec_fe_mul(&t0, &t2, &t3, curve);
+    ec_fe_sub(&x3, &x3, &t0, curve);
+    ec_fe_mul(&z3, &t2, &t1, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+
+    rop->x = x3;
+    rop->y = y3;
+    rop->z = z3;
+}
+
+// rop = op1 + op2 in projective coordinates for a = -3 (algorithm 4), 12M + 2 * b
+static void ec_complete_add_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op1, ecc_jacobian_point_t *op2, ecc_curve_t *curve)
+{
+    ec_fe_t t0, t1, t2, t3, t4, x3, y3, z3;
+
+    ec_fe_mul(&t0, &op1->x, &op2->x, curve);
+    ec_fe_mul(&t1, &op1->y, &op2->y, curve);
+    ec_fe_mul(&t2, &op1->z, &op2->z, curve);
+    ec_fe_add(&t3, &op1->x, &op1->y, curve);
+    ec_fe_add(&t4, &op2->x, &op2->y, curve);
+    ec_fe_mul(&t3, &t3, &t4, curve);
+    ec_fe_add(&t4, &t0, &t1, curve);
+    ec_fe_sub(&t3, &t3, &t4, curve);
+    ec_fe_add(&t4, &op1->y, &op1->z, curve);
+    ec_fe_add(&x3, &op2->y, &op2->z, curve);
+    ec_fe_mul(&t4, &t4, &x3, curve);
+    ec_fe_add(&x3, &t1, &t2, curve);
+    ec_fe_sub(&t4, &t4, &x3, curve);
+    ec_fe_add(&x3, &op1->x, &op1->z, curve);
+    ec_fe_add(&y3, &op2->x, &op2->z, curve);
+    ec_fe_mul(&x3, &x3, &y3, curve);
+    ec_fe_add(&y3, &t0, &t2, curve);
+    ec_fe_sub(&y3, &x3, &y3, curve);
+    ec_fe_mul(&z3, &curve->bm, &t2, curve);
+    ec_fe_sub(&x3, &y3, &z3, curve);
+    ec_fe_add(&z3, &x3, &x3, curve);
+    ec_fe_add(&x3, &x3, &z3, curve);
+    ec_fe_sub(&z3, &t1, &x3, curve);
+    ec_fe_add(&x3, &t1, &x3, curve);
+    ec_fe_mul(&y3, &curve->bm, &y3, curve);
+    ec_fe_add(&t1, &t2, &t2, curve);
+    ec_fe_add(&t2, &t1, &t2, curve);
+    ec_fe_sub(&y3, &y3, &t2, curve);
+    ec_fe_sub(&y3, &y3, &t0, curve);
+    ec_fe_add(&t1, &y3, &y3, curve);
+    ec_fe_add(&y3, &t1, &y3, curve);
+    ec_fe_add(&t1, &t0, &t0, curve);
+    ec_fe_add(&t0, &t1, &t0, curve);
+    ec_fe_sub(&t0, &t0, &t2, curve);
+    ec_fe_mul(&t1, &t4, &y3, curve);
+    ec_fe_mul(&t2, &t0, &y3, curve);
+    ec_fe_mul(&y3, &x3, &z3, curve);
+    ec_fe_add(&y3, &y3, &t2, curve);
+    ec_fe_mul(&x3, &t3, &x3, curve);
+    ec_fe_sub(&x3, &x3, &t1, curve);
+    ec_fe_mul(&z3, &t4, &z3, curve);
+    ec_fe_mul(&t1, &t3, &t0, curve);
+    ec_fe_add(&z3, &z3, &t1, curve);
+
+    rop->x = x3;
+    rop->y = y3;
+    rop->z = z3;
+}
+
+// rop = 2 * op in projective coordinates for a = -3 (algorithm 6), 8M + 3S + 2 * b
+static void ec_complete_double_a3(ecc_jacobian_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    ec_fe_t t0, t1, t2, t3, x3, y3, z3;
+
+    ec_fe_sqr(&t0, &op->x, curve);
+    ec_fe_sqr(&t1, &op->y, curve);
+    ec_fe_sqr(&t2, &op->z, curve);
+    ec_fe_mul(&t3, &op->x, &op->y, curve);
+    ec_fe_add(&t3, &t3, &t3, curve);
+    ec_fe_mul(&z3, &op->x, &op->z, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+    ec_fe_mul(&y3, &curve->bm, &t2, curve);
+    ec_fe_sub(&y3, &y3, &z3, curve);
+    ec_fe_add(&x3, &y3, &y3, curve);
+    ec_fe_add(&y3, &x3, &y3, curve);
+    ec_fe_sub(&x3, &t1, &y3, curve);
+    ec_fe_add(&y3, &t1, &y3, curve);
+    ec_fe_mul(&y3, &x3, &y3, curve);
+    ec_fe_mul(&x3, &x3, &t3, curve);
+    ec_fe_add(&t3, &t2, &t2, curve);
+    ec_fe_add(&t2, &t2, &t3, curve);
+    ec_fe_mul(&z3, &curve->bm, &z3, curve);
+    ec_fe_sub(&z3, &z3, &t2, curve);
+    ec_fe_sub(&z3, &z3, &t0, curve);
+    ec_fe_add(&t3, &z3, &z3, curve);
+    ec_fe_add(&z3, &z3, &t3, curve);
+    ec_fe_add(&t3, &t0, &t0, curve);
+    ec_fe_add(&t0, &t3, &t0, curve);
+    ec_fe_sub(&t0, &t0, &t2, curve);
+    ec_fe_mul(&t0, &t0, &z3, curve);
+    ec_fe_add(&y3, &y3, &t0, curve);
+    ec_fe_mul(&t0, &op->y, &op->z, curve);
+    ec_fe_add(&t0, &t0, &t0, curve);
+    ec_fe_mul(&z3, &t0, &z3, curve);
+    ec_fe_sub(&x3, &x3, &z3, curve);
+    ec_fe_mul(&z3, &t0, &t1, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+    ec_fe_add(&z3, &z3, &z3, curve);
+
+    rop->x = x3;
+    rop->y = y3;
+    rop->z = z3;
+}
+
+// converts from projective coordinates to affine and leaves the montgomery domain
+static void ec_projective_to_affine(ecc_point_t *rop, ecc_jacobian_point_t *op, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if (ec_fe_iszero(&op->z, curve))
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+
+    ec_fe_t zinv, x, y;
+
+    // x = X / Z, y = Y / Z
+    ec_fe_invert(&zinv, &op->z, curve);
+    ec_fe_mul(&x, &op->x, &zinv, curve);
+    ec_fe_mul(&y, &op->y, &zinv, curve);
+    ec_fe_to_affine(rop, &x, &y, curve);
+}
+
+// count bits of k starting at bit, count <= DIGIT_BIT - 1
+static fp_digit ec_scalar_bits(fp_int *k, int bit, int count)
+{
+    int digit = bit / DIGIT_BIT, shift = bit % DIGIT_BIT;
+    fp_digit bits = (digit < k->used) ? (k->dp[digit] >> shift) : 0;
+    if (shift + count > DIGIT_BIT && digit + 1 < k->used)
+    {
+        bits |= k->dp[digit + 1] << (DIGIT_BIT - shift);
+    }
+    return bits & (((fp_digit)1 << count) - 1);
+}
+
+// width-w non adjacent form of |k|: naf[i] is zero or odd in (-2^(w-1), 2^(w-1)), returns the number of digits
+static int ec_scalar_wnaf(int8_t *naf, fp_int *k, int w)
+{
+    int len = fp_count_bits(k) + 1;
+    int bit = 0, carry = 0;
+
+    memset(naf, 0, len * sizeof(int8_t));
+    while (bit < len)
+    {
+        if ((int)ec_scalar_bits(k, bit, 1) == carry)
+        {
+            bit++;
+            continue;
+        }
+
+        int now = (len - bit < w) ? len - bit : w;
+        int word = (int)ec_scalar_bits(k, bit, now) + carry;
+
+        carry = (word >> (w - 1)) & 1;
+        word -= carry << w;
+        naf[bit] = (int8_t)word;
+        bit += now;
+    }
+    return len;
+}
+
+// bits[i] = bit i of |k| for i < len, one byte per bit for the ladders
+static void ec_scalar_binary(uint8_t *bits, fp_int *k, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        bits[i] = (uint8_t)ec_scalar_bits(k, i, 1);
+    }
+}
+
+// regular signed base 2^w digits of an odd k, every digit odd in [-(2^w - 1), 2^w - 1], k is consumed
+static void ec_scalar_regular(int *digits, fp_int *k, size_t windows, int w)
+{
+    for (size_t i = 0; i < windows - 1; i++)
+    {
+        int digit = (int)(k->dp[0] & ((1 << (w + 1)) - 1)) - (1 << w);
+        if (digit < 0)
+        {
+            fp_add_d(k, (fp_digit)-digit, k);
+        }
+        else
+        {
+            fp_sub_d(k, (fp_digit)digit, k);
+        }
+        fp_div_2d(k, w, k, NULL);
+        digits[i] = digit;
+    }
+    digits[windows - 1] = (int)k->dp[0];
+}
+
+// signed base 2^c digits of |k| in [-2^(c-1), 2^(c-1)], returns the number of digits
+static int ec_scalar_signed_digits(int16_t *digits, fp_int *k, int c)
+{
+    int len = fp_count_bits(k) / c + 1;
+    int carry = 0;
+
+    for (int i = 0; i < len; i++)
+    {
+        int word = (int)ec_scalar_bits(k, i * c, c) + carry;
+
+        carry = (word > (1 << (c - 1))) ? 1 : 0;
+        digits[i] = (int16_t)(word - (carry << c));
+    }
+    return len;
+}
+
+// rop = scalar * point with the complete formulas of the curve: a montgomery ladder over the bits of q
+// with conditional swaps, the same sequence of operations for every scalar. the formulas are complete
+// on prime order curves only, there the point has order q and the scalar is taken mod q
+static void ec_point_mul_complete(ecc_point_t *rop, ecc_point_t *point, fp_int *scalar, ecc_curve_t *curve)
+{
+    size_t limbs = curve->limbs;
+    int bits = fp_count_bits(curve->q);
+    uint8_t *k = m_new(uint8_t, bits);
+    fp_int *kk = fp_alloc_scratch();
+    ecc_jacobian_point_t R0, R1;
+
+    // k = |scalar| mod q, a negative scalar negates the point
+    fp_digit neg = (fp_digit)0 - (fp_digit)(scalar->sign == FP_NEG);
+    fp_abs(scalar, kk);
+    fp_mod(kk, curve->q, kk);
+    ec_scalar_binary(k, kk, bits);
+
+    // R1 = point or -point, R0 = (0 : 1 : 0)
+    ec_point_to_jacobian(&R1, point, curve);
+    ec_fe_neg(&R0.y, &R1.y, curve);
+    ec_fe_cmov(&R1.y, &R0.y, neg, limbs);
+    ec_fe_zero(&R0.x, curve);
+    R0.y = curve->one;
+    ec_fe_zero(&R0.z, curve);
+
+    fp_digit swap = 0;
+    for (int i = bits - 1; i >= 0; i--)
+    {
+        fp_digit bit = k[i];
+        fp_digit mask = (fp_digit)0 - (bit ^ swap);
+        ec_fe_cswap(&R0.x, &R1.x, mask, limbs);
+        ec_fe_cswap(&R0.y, &R1.y, mask, limbs);
+        ec_fe_cswap(&R0.z, &R1.z, mask, limbs);
+        swap = bit;
+
+        curve->complete->add(&R1, &R0, &R1, curve);
+        curve->complete->dbl(&R0, &R0, curve);
+    }
+    ec_fe_cswap(&R0.x, &R1.x, (fp_digit)0 - swap, limbs);
+    ec_fe_cswap(&R0.y, &R1.y, (fp_digit)0 - swap, limbs);
+    ec_fe_cswap(&R0.z, &R1.z, (fp_digit)0 - swap, limbs);
+
+    ec_projective_to_affine(rop, &R0, curve);
+
+    fp_free(kk);
+    m_del(uint8_t, k, bits);
+}
+
+// dst[i] = affine (2i + 1) * P for i < n as limbs in the montgomery domain, with a single inversion,
+// multiples that are the identity element are stored as (0, 0) and make it return false
+static bool ec_odd_multiples_store(fp_digit *dst, ecc_jacobian_point_t *P, size_t n, size_t limbs, ecc_curve_t *curve)
+{
+    fp_digit *jacobian = m_new(fp_digit, n * 3 * limbs);
+    fp_digit *prefix = m_new(fp_digit, n * limbs);
+    ecc_jacobian_point_t T, P2;
+    ec_fe_t acc, zinv, zinv2;
+    bool finite = true;
+
+    ec_jacobian_double(&P2, P, curve);
+    T = *P;
+    acc = curve->one;
+    for (size_t i = 0; i < n; i++)
+    {
+        // T = (2i + 1) * P
+        fp_digit *entry = &jacobian[i * 3 * limbs];
+        ec_fe_store(entry, &T.x, limbs);
+        ec_fe_store(entry + limbs, &T.y, limbs);
+        ec_fe_store(entry + (2 * limbs), &T.z, limbs);
+
+        // prefix[i] = product of the non zero Z up to i
+        if (!ec_fe_iszero(&T.z, curve))
+        {
+            ec_fe_mul(&acc, &acc, &T.z, curve);
+        }
+        else
+        {
+            finite = false;
+        }
+        ec_fe_store(&prefix[i * limbs], &acc, limbs);
+
+        if (i + 1 < n)
+        {
+            ec_jacobian_add(&T, &T, &P2, curve);
+        }
+    }
+
+    ec_fe_invert(&acc, &acc, curve);
+
+    for (size_t i = n; i-- > 0;)
+    {
+        fp_digit *entry = &jacobian[i * 3 * limbs];
+        fp_digit *affine = &dst[i * 2 * limbs];
+
+        ec_fe_load(&T.z, entry + (2 * limbs), limbs);
+        if (ec_fe_iszero(&T.z, curve))
+        {
+            memset(affine, 0, 2 * limbs * sizeof(fp_digit));
+            continue;
+        }
+
+        // Z^-1 = prefix[i]^-1 * prefix[i - 1], then drop Z from prefix[i]^-1
+        if (i > 0)
+        {
+            ec_fe_load(&zinv, &prefix[(i - 1) * limbs], limbs);
+            ec_fe_mul(&zinv, &acc, &zinv, curve);
+        }
+        else
+        {
+            zinv = acc;
+        }
+        ec_fe_mul(&acc, &acc, &T.z, curve);
+
+        // x = X / Z^2, y = Y / Z^3
+        ec_fe_load(&T.x, entry, limbs);
+        ec_fe_load(&T.y, entry + limbs, limbs);
+        ec_fe_sqr(&zinv2, &zinv, curve);
+        ec_fe_mul(&T.x, &T.x, &zinv2, curve);
+        ec_fe_mul(&zinv2, &zinv2, &zinv, curve);
+        ec_fe_mul(&T.y, &T.y, &zinv2, curve);
+        ec_fe_store(affine, &T.x, limbs);
+        ec_fe_store(affine + limbs, &T.y, limbs);
+    }
+
+    m_del(fp_digit, jacobian, n * 3 * limbs);
+    m_del(fp_digit, prefix, n * limbs);
+    return finite;
+}
+
+static ecc_odd_multiples_t *ec_odd_multiples_new(ecc_point_t *point, int w, ecc_curve_t *curve)
+{
+    size_t n = (size_t)1 << (w - 2);
+    ecc_odd_multiples_t *table = m_new_obj(ecc_odd_multiples_t);
+    table->w = w;
+    table->limbs = curve->limbs;
+    table->points = m_new(fp_digit, n * 2 * table->limbs);
+
+    ecc_jacobian_point_t P;
+    ec_point_to_jacobian(&P, point, curve);
+    ec_odd_multiples_store(table->points, &P, n, table->limbs, curve);
+    return table;
+}
+
+static void ec_odd_multiples_free(ecc_odd_multiples_t *table)
+{
+    if (table != NULL)
+    {
+        m_del(fp_digit, table->points, ((size_t)1 << (table->w - 2)) * 2 * table->limbs);
+        m_del_obj(ecc_odd_multiples_t, table);
+    }
+}
+
+// rop = digit * P for an odd digit, in variable time
+static void ec_odd_multiples_get(ecc_jacobian_point_t *rop, ecc_odd_multiples_t *table, int digit, ecc_curve_t *curve)
+{
+    size_t limbs = table->limbs;
+    fp_digit *entry = &table->points[((digit < 0 ? -digit : digit) >> 1) * 2 * limbs];
+
+    ec_fe_load(&rop->x, entry, limbs);
+    ec_fe_load(&rop->y, entry + limbs, limbs);
+
+    // handle the identity element
+    if (ec_fe_iszero(&rop->x, curve) && ec_fe_iszero(&rop->y, curve))
+    {
+        ec_jacobian_set_identity(rop, curve);
+        return;
+    }
+
+    rop->z = curve->one;
+    if (digit < 0)
+    {
+        ec_fe_neg(&rop->y, &rop->y, curve);
+    }
+}
+
+static bool ec_generator_table_build(ecc_generator_table_t *table, ecc_curve_t *curve)
+{
+    size_t half = (size_t)1 << (ECC_G_WINDOW_BITS - 1);
+    size_t limbs = curve->limbs;
+    size_t pbits = fp_count_bits(curve->p);
+    // ecdsa nonces may come as k + q or k + 2q to hide their bit length
+    size_t qbits = fp_count_bits(curve->q) + 2;
+    size_t bits = (pbits > qbits ? pbits : qbits);
+    size_t windows = (bits + ECC_G_WINDOW_BITS - 1) / ECC_G_WINDOW_BITS;
+
+    fp_digit *points = m_new_maybe(fp_digit, windows * half * 2 * limbs);
+    if (points == NULL)
+    {
+        return false;
+    }
+
+    ecc_jacobian_point_t B;
+    bool ok = true;
+
+    ec_point_to_jacobian(&B, curve->g, curve);
+    for (size_t i = 0; i < windows && ok; i++)
+    {
+        // window i = (2j + 1) * B, with B = 2^(w * i) * G, G of small order fails
+        ok = ec_odd_multiples_store(&points[i * half * 2 * limbs], &B, half, limbs, curve);
+
+        for (size_t j = 0; j < ECC_G_WINDOW_BITS; j++)
+        {
+            ec_jacobian_double(&B, &B, curve);
+        }
+    }
+
+    if (!ok)
+    {
+        m_del(fp_digit, points, windows * half * 2 * limbs);
+        return false;
+    }
+
+    table->bits = bits;
+    table->windows = windows;
+    table->limbs = limbs;
+    table->points = points;
+    return true;
+}
+
+// odd multiples of G for the wNAF paths, built on first use
+static ecc_odd_multiples_t *ec_generator_odd_multiples(ecc_curve_t *curve)
+{
+    if (curve->gtable->odd == NULL)
+    {
+        curve->gtable->odd = ec_odd_multiples_new(curve->g, ECC_G_WNAF_WINDOW_BITS, curve);
+    }
+    return curve->gtable->odd;
+}
+
+// rop = digit * 2^(w * window) * G, digit odd, reading every entry of the window
+static void ec_generator_table_select(ecc_jacobian_point_t *rop, ecc_generator_table_t *table, size_t window, int digit, ecc_curve_t *curve)
+{
+    size_t half = (size_t)1 << (ECC_G_WINDOW_BITS - 1);
+    size_t limbs = table->limbs;
+    fp_digit *entries = &table->points[window * half * 2 * limbs];
+
+    // sign = 0 or 1, index = (|digit| - 1) / 2
+    fp_digit sign = (fp_digit)(digit < 0);
+    fp_digit index = (fp_digit)(((digit ^ -(int)sign) + (int)sign - 1) >> 1);
+
+    ec_fe_zero(&rop->x, curve);
+    ec_fe_zero(&rop->y, curve);
+    for (size_t j = 0; j < half; j++)
+    {
+        fp_digit mask = ((fp_digit)j ^ index) - 1;
+        mask = (fp_digit)0 - (mask >> (DIGIT_BIT - 1));
+        for (size_t l = 0; l < limbs; l++)
+        {
+            rop->x.dp[l] |= entries[(j * 2 * limbs) + l] & mask;
+            rop->y.dp[l] |= entries[(j * 2 * limbs) + limbs + l] & mask;
+        }
+    }
+
+    // negative digits select -y
+    ec_fe_neg(&rop->z, &rop->y, curve);
+    ec_fe_cmov(&rop->y, &rop->z, (fp_digit)0 - sign, limbs);
+    rop->z = curve->one;
+}
+
+// rop = scalar * G with the fixed-window table of the curve, no doublings and one addition per window,
+// returns false if the table can't be used and the caller has to fall back to the ladder
+static bool ec_point_mul_generator(ecc_point_t *rop, fp_int *scalar, ecc_curve_t *curve)
+{
+    ecc_generator_table_t *table = curve->gtable;
+    if (table->points == NULL)
+    {
+        if (table->failed || !ec_generator_table_build(table, curve))
+        {
+            table->failed = true;
+            return false;
+        }
+    }
+
+    fp_int *k = fp_alloc_scratch();
+    fp_abs(scalar, k);
+    if ((size_t)fp_count_bits(k) > table->bits)
+    {
+        fp_free(k);
+        return false;
+    }
+
+    // the recoding needs an odd scalar: use k + 1 for even k and subtract G at the end
+    fp_digit even = (k->dp[0] & 1) ^ 1;
+    k->dp[0] |= 1;
+
+    size_t windows = table->windows;
+    int *digits = m_new(int, windows);
+    ec_scalar_regular(digits, k, windows, ECC_G_WINDOW_BITS);
+
+    ecc_jacobian_point_t R, T;
+
+    // the table entries (x, y, 1) are valid in projective coordinates as well
+    ec_generator_table_select(&R, table, 0, digits[0], curve);
+    for (size_t i = 1; i < windows; i++)
+    {
+        ec_generator_table_select(&T, table, i, digits[i], curve);
+        if (curve->complete != NULL)
+        {
+            curve->complete->add(&R, &R, &T, curve);
+        }
+        else
+        {
+            ec_jacobian_add_mixed(&R, &R, &T, curve);
+        }
+    }
+
+    // R - G, kept only if k was even
+    ec_generator_table_select(&T, table, 0, -1, curve);
+    if (curve->complete != NULL)
+    {
+        curve->complete->add(&T, &R, &T, curve);
+        ec_jacobian_cmov(&R, &T, (fp_digit)0 - even, table->limbs);
+        ec_projective_to_affine(rop, &R, curve);
+    }
+    else
+    {
+        ec_jacobian_add_mixed(&T, &R, &T, curve);
+        ec_jacobian_cmov(&R, &T, (fp_digit)0 - even, table->limbs);
+        ec_jacobian_to_affine(rop, &R, curve);
+    }
+
+    if (fp_cmp_d(scalar, 0) == FP_LT && fp_iszero(rop->y) == FP_NO)
+    {
+        // -y % curve.p
+        fp_sub(curve->p, rop->y, rop->y);
+    }
+
+    m_del(int, digits, windows);
+    fp_free(k);
+    return true;
+}
+
+static void ec_point_mul(ecc_point_t *rop, ecc_point_t *point, fp_int *scalar, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if ((fp_cmp_d(point->x, 0) == FP_EQ && fp_cmp_d(point->y, 0) == FP_EQ) || fp_iszero(scalar) == FP_YES)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+
+    // multiples of the generator use the precomputed table of the curve
+    if (ec_point_equal(point, curve->g) && ec_point_mul_generator(rop, scalar, curve))
+    {
+        return;
+    }
+
+    if (curve->complete != NULL)
+    {
+        ec_point_mul_complete(rop, point, scalar, curve);
+        return;
+    }
+
+    int dbits = fp_count_bits(scalar);
+    uint8_t *k = m_new(uint8_t, dbits);
+    ecc_jacobian_point_t R0, R1;
+
+    // the bits of |scalar|, the sign goes to the point
+    ec_scalar_binary(k, scalar, dbits);
+    ec_point_to_jacobian(&R0, point, curve);
+    if (fp_cmp_d(scalar, 0) == FP_LT)
+    {
+        // -point.y % curve.p
+        ec_fe_neg(&R0.y, &R0.y, curve);
+    }
+
+    ec_jacobian_double(&R1, &R0, curve);
+
+    for (int i = dbits - 2; i >= 0; i--)
+    {
+        if (k[i])
+        {
+            ec_jacobian_add(&R0, &R0, &R1, curve);
+            ec_jacobian_double(&R1, &R1, curve);
+        }
+        else
+        {
+            ec_jacobian_add(&R1, &R0, &R1, curve);
+            ec_jacobian_double(&R0, &R0, curve);
+        }
+    }
+
+    // a single inversion to get back the affine coordinates
+    ec_jacobian_to_affine(rop, &R0, curve);
+
+    m_del(uint8_t, k, dbits);
+}
+
+// rop = sum of scalars[i] * P[i] given the odd multiples of every P[i], interleaving the wNAF of the scalars
+// so that all terms share the doublings (Straus), P[i] is taken through the endomorphism when endo[i] is set
+static void ec_point_mul_straus_terms(ecc_jacobian_point_t *rop, ecc_odd_multiples_t **tables, fp_int **scalars, const bool *endo, size_t n, ecc_curve_t *curve)
+{
+    int8_t **naf = m_new(int8_t *, n);
+    int *len = m_new(int, n);
+    int maxlen = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        naf[i] = m_new(int8_t, fp_count_bits(scalars[i]) + 1);
+        len[i] = ec_scalar_wnaf(naf[i], scalars[i], tables[i]->w);
+        if (scalars[i]->sign == FP_NEG)
+        {
+            for (int j = 0; j < len[i]; j++)
+            {
+                naf[i][j] = -naf[i][j];
+            }
+        }
+        if (len[i] > maxlen)
+        {
+            maxlen = len[i];
+        }
+    }
+
+    ecc_jacobian_point_t T;
+
+    ec_jacobian_set_identity(rop, curve);
+    for (int bit = maxlen - 1; bit >= 0; bit--)
+    {
+        ec_jacobian_double(rop, rop, curve);
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (bit < len[i] && naf[i][bit] != 0)
+            {
+                ec_odd_multiples_get(&T, tables[i], naf[i][bit], curve);
+                if (endo != NULL && endo[i] && !ec_fe_iszero(&T.z, curve))
+                {
+                    ec_fe_mul(&T.x, &T.x, &curve->beta, curve);
+                }
+                ec_jacobian_add_mixed(rop, rop, &T, curve);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        m_del(int8_t, naf[i], fp_count_bits(scalars[i]) + 1);
+    }
+    m_del(int8_t *, naf, n);
+    m_del(int, len, n);
+}
+
+// k = k1 + k2 * lambda mod q with |k1| and |k2| about sqrt(q), rounding k against the short basis (GLV)
+static void ec_scalar_glv_split(fp_int *k1, fp_int *k2, fp_int *k, ecc_curve_t *curve)
+{
+    const ecc_glv_t *glv = curve->glv;
+    fp_int *c1 = fp_alloc_scratch();
+    fp_int *c2 = fp_alloc_scratch();
+    fp_int *half = fp_alloc_scratch();
+    fp_int *t = fp_alloc_scratch();
+
+    fp_mod(k, curve->q, k1);
+    fp_div_2(curve->q, half);
+
+    // c1 = round(b2 * k / q), c2 = round(-b1 * k / q)
+    fp_store_words32(t, glv->b2, glv->words);
+    fp_mul(t, k1, c1);
+    fp_add(c1, half, c1);
+    fp_div(c1, curve->q, c1, NULL);
+    fp_store_words32(t, glv->minus_b1, glv->words);
+    fp_mul(t, k1, c2);
+    fp_add(c2, half, c2);
+    fp_div(c2, curve->q, c2, NULL);
+
+    // k1 = k - c1 * a1 - c2 * a2, k2 = -c1 * b1 - c2 * b2
+    fp_store_words32(t, glv->a1, glv->words);
+    fp_mul(c1, t, t);
+    fp_sub(k1, t, k1);
+    fp_store_words32(t, glv->a2, glv->words);
+    fp_mul(c2, t, t);
+    fp_sub(k1, t, k1);
+    fp_store_words32(t, glv->minus_b1, glv->words);
+    fp_mul(c1, t, k2);
+    fp_store_words32(t, glv->b2, glv->words);
+    fp_mul(c2, t, t);
+    fp_sub(k2, t, k2);
+
+    fp_free(c1);
+    fp_free(c2);
+    fp_free(half);
+    fp_free(t);
+}
+
+// rop = sum of scalars[i] * P[i] with Straus, in variable time, for public scalars only. with an endomorphism
+// every long term becomes k1 * P + k2 * endo(P), halving the doublings, and both halves share the table of P
+static void ec_point_mul_straus(ecc_jacobian_point_t *rop, ecc_odd_multiples_t **tables, fp_int **scalars, size_t n, ecc_curve_t *curve)
+{
+    if (curve->glv == NULL)
+    {
+        ec_point_mul_straus_terms(rop, tables, scalars, NULL, n, curve);
+        return;
+    }
+
+    ecc_odd_multiples_t **split_tables = m_new(ecc_odd_multiples_t *, 2 * n);
+    fp_int **split_scalars = m_new(fp_int *, 2 * n);
+    bool *endo = m_new(bool, 2 * n);
+    int short_bits = (fp_count_bits(curve->q) + 1) / 2 + 1;
+    size_t m = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        split_tables[m] = tables[i];
+        split_scalars[m] = fp_alloc();
+        endo[m] = false;
+
+        // scalars as short as the halves are kept whole
+        if (fp_count_bits(scalars[i]) <= short_bits)
+        {
+            fp_copy(scalars[i], split_scalars[m++]);
+            continue;
+        }
+
+        split_tables[m + 1] = tables[i];
+        split_scalars[m + 1] = fp_alloc();
+        endo[m + 1] = true;
+        ec_scalar_glv_split(split_scalars[m], split_scalars[m + 1], scalars[i], curve);
+        m += 2;
+    }
+
+    ec_point_mul_straus_terms(rop, split_tables, split_scalars, endo, m, curve);
+
+    for (size_t i = 0; i < m; i++)
+    {
+        fp_free(split_scalars[i]);
+    }
+    m_del(ecc_odd_multiples_t *, split_tables, 2 * n);
+    m_del(fp_int *, split_scalars, 2 * n);
+    m_del(bool, endo, 2 * n);
+}
+
+// odd multiples of point, the cached ones for G, a new table otherwise
+static ecc_odd_multiples_t *ec_point_odd_multiples(ecc_point_t *point, ecc_curve_t *curve)
+{
+    if (ec_point_equal(point, curve->g))
+    {
+        return ec_generator_odd_multiples(curve);
+    }
+    return ec_odd_multiples_new(point, ECC_WNAF_WINDOW_BITS, curve);
+}
+
+static void ec_point_odd_multiples_free(ecc_odd_multiples_t *table, ecc_curve_t *curve)
+{
+    if (table != curve->gtable->odd)
+    {
+        ec_odd_multiples_free(table);
+    }
+}
+
+// rop = scalar * point in variable time, for public scalars only
+static void ec_point_mul_wnaf(ecc_point_t *rop, ecc_point_t *point, fp_int *scalar, ecc_curve_t *curve)
+{
+    // handle the identity element
+    if ((fp_cmp_d(point->x, 0) == FP_EQ && fp_cmp_d(point->y, 0) == FP_EQ) || fp_iszero(scalar) == FP_YES)
+    {
+        fp_set(rop->x, 0);
+        fp_set(rop->y, 0);
+        return;
+    }
+
+    ecc_odd_multiples_t *table = ec_point_odd_multiples(point, curve);
+    ecc_jacobian_point_t R;
+
+    ec_point_mul_straus(&R, &table, &scalar, 1, curve);
+
+    // a single inversion to get back the affine coordinates
+    ec_jacobian_to_affine(rop, &R, curve);
+
+    ec_point_odd_multiples_free(table, curve);
+}
+
+// co-Z addition of P = (X1, Y1) and Q = (X2, Y2) sharing Z: Q = P + Q and P = P with the new Z, which is
+// Z * (X2 - X1) with dz = X2 - X1 (XYCZ-ADD of Rivain, "Fast and regular algorithms for scalar multiplication
+// over elliptic curves"), the Z of P and Q are not used, t holds 3 temporaries
+static void ec_coz_add(ecc_jacobian_point_t *P, ecc_jacobian_point_t *Q, ec_fe_t *dz, ec_fe_t *t, ecc_curve_t *curve)
+{
+    // A = (X2 - X1)^2, B = X1 * A, C = X2 * A, E = Y1 * (C - B)
+    ec_fe_sub(dz, &Q->x, &P->x, curve);
+    ec_fe_sqr(&t[0], dz, curve);
+    ec_fe_mul(&P->x, &P->x, &t[0], curve);
+    ec_fe_mul(&Q->x, &Q->x, &t[0], curve);
+    ec_fe_sub(&t[1], &Q->y, &P->y, curve);
+    ec_fe_sub(&t[0], &Q->x, &P->x, curve);
+    ec_fe_mul(&P->y, &P->y, &t[0], curve);
+
+    // X3 = (Y2 - Y1)^2 - B - C, Y3 = (Y2 - Y1) * (B - X3) - E
+    ec_fe_sqr(&t[0], &t[1], curve);
+    ec_fe_sub(&t[0], &t[0], &P->x, curve);
+    ec_fe_sub(&Q->x, &t[0], &Q->x, curve);
+    ec_fe_sub(&t[0], &P->x, &Q->x, curve);
+    ec_fe_mul(&t[0], &t[1], &t[0], curve);
+    ec_fe_sub(&Q->y, &t[0], &P->y, curve);
+}
+
+// conjugate co-Z addition: Q = P + Q and P = P - Q, sharing the new Z = Z * dz (XYCZ-ADDC)
+static void ec_coz_addc(ecc_jacobian_point_t *P, ecc_jacobian_point_t *Q, ec_fe_t *dz, ec_fe_t *t, ecc_curve_t *curve)
+{
+    // A = (X2 - X1)^2, B = X1 * A, C = X2 * A, E = Y1 * (C - B)
+    ec_fe_sub(dz, &Q->x, &P->x, curve);
+    ec_fe_sqr(&t[0], dz, curve);
+    ec_fe_mul(&t[1], &P->x, &t[0], curve);
+    ec_fe_mul(&t[0], &Q->x, &t[0], curve);
+    ec_fe_sub(&t[2], &Q->y, &P->y, curve);
+    ec_fe_add(&Q->y, &Q->y, &P->y, curve);
+    ec_fe_sub(&Q->x, &t[0], &t[1], curve);
+    ec_fe_mul(&P->y, &P->y, &Q->x, curve);
+    ec_fe_add(&t[0], &t[0], &t[1], curve);
+
+    // X3 = (Y2 - Y1)^2 - B - C, X3' = (Y1 + Y2)^2 - B - C
+    ec_fe_sqr(&Q->x, &t[2], curve);
+    ec_fe_sub(&Q->x, &Q->x, &t[0], curve);
+    ec_fe_sqr(&P->x, &Q->y, curve);
+    ec_fe_sub(&P->x, &P->x, &t[0], curve);
+
+    // Y3' = (Y1 + Y2) * (X3' - B) - E, Y3 = (Y2 - Y1) * (B - X3) - E
+    ec_fe_sub(&t[0], &P->x, &t[1], curve);
+    ec_fe_mul(&t[0], &Q->y, &t[0], curve);
+    ec_fe_sub(&t[1], &t[1], &Q->x, curve);
+    ec_fe_mul(&t[1], &t[2], &t[1], curve);
+    ec_fe_sub(&Q->y, &t[1], &P->y, curve);
+    ec_fe_sub(&P->y, &t[0], &P->y, curve);
+}
+
+// x = x of k * point for 0 < k < q, point affine and reduced, with the co-Z montgomery ladder: m is a
+// multiple of q the order of point divides, every bit costs the same XYCZ-ADDC and XYCZ-ADD and the ladder
+// runs on k + m or k + 2m, whichever has one bit more than m, so neither the sequence of operations nor
+// its length depend on k. returns false if an intermediate sum hit the identity element
+static bool ec_point_mul_x_coz(fp_int *x, ecc_point_t *point, fp_int *k, fp_int *m, ecc_curve_t *curve)
+{
+    size_t limbs = curve->limbs;
+    int bits = fp_count_bits(m) + 1;
+    fp_int *kk = fp_alloc_scratch();
+    fp_int *k2 = fp_alloc_scratch();
+    ec_fe_t t[3], z, dz;
+    ecc_jacobian_point_t R[2];
+
+    // kk = k + m, or k + 2m if k + m is too short
+    fp_add(k, m, kk);
+    fp_add(kk, m, k2);
+    fp_cmov(kk, k2, (fp_digit)0 - (ec_scalar_bits(kk, bits - 1, 1) ^ 1), (size_t)m->used + 1);
+
+    // R1 = 2P and R0 = P sharing Z = 2y: S = 4 * x * y^2, M = 3 * x^2 + a, R0 = (S, 8 * y^4),
+    // R1 = (M^2 - 2 * S, M * (S - X(R1)) - 8 * y^4)
+    ec_fe_t *px = &R[1].x, *py = &R[1].y;
+    ec_fe_from_fp(px, point->x, curve);
+    ec_fe_from_fp(py, point->y, curve);
+    ec_fe_to_montgomery(px, px, curve);
+    ec_fe_to_montgomery(py, py, curve);
+    ec_fe_add(&z, py, py, curve);
+    ec_fe_sqr(&t[0], py, curve);
+    ec_fe_mul(&R[0].x, px, &t[0], curve);
+    ec_fe_add(&R[0].x, &R[0].x, &R[0].x, curve);
+    ec_fe_add(&R[0].x, &R[0].x, &R[0].x, curve);
+    ec_fe_sqr(&R[0].y, &t[0], curve);
+    ec_fe_add(&R[0].y, &R[0].y, &R[0].y, curve);
+    ec_fe_add(&R[0].y, &R[0].y, &R[0].y, curve);
+    ec_fe_add(&R[0].y, &R[0].y, &R[0].y, curve);
+    ec_fe_sqr(&t[1], px, curve);
+    ec_fe_add(&t[0], &t[1], &t[1], curve);
+    ec_fe_add(&t[0], &t[0], &t[1], curve);
+    ec_fe_add(&t[0], &t[0], &curve->am, curve);
+    ec_fe_sqr(&t[1], &t[0], curve);
+    ec_fe_sub(&t[1], &t[1], &R[0].x, curve);
+    ec_fe_sub(&R[1].x, &t[1], &R[0].x, curve);
+    ec_fe_sub(&t[1], &R[0].x, &R[1].x, curve);
+    ec_fe_mul(&t[1], &t[0], &t[1], curve);
+    ec_fe_sub(&R[1].y, &t[1], &R[0].y, curve);
+
+    // R1 - R0 = P, for bit b: R(1 - b) = R(b) + R(1 - b), R(b) = 2 * R(b)
+    uint8_t *kbits = m_new(uint8_t, bits);
+    ec_scalar_binary(kbits, kk, bits);
+    fp_digit swap = 0;
+    for (int i = bits - 2; i >= 0; i--)
+    {
+        fp_digit b = kbits[i];
+        fp_digit mask = (fp_digit)0 - (b ^ swap);
+        ec_fe_cswap(&R[0].x, &R[1].x, mask, limbs);
+        ec_fe_cswap(&R[0].y, &R[1].y, mask, limbs);
+        swap = b;
+
+        // R0 is R(b) and R1 is R(1 - b)
+        ec_coz_addc(&R[0], &R[1], &dz, t, curve);
+        ec_fe_mul(&z, &z, &dz, curve);
+        ec_coz_add(&R[1], &R[0], &dz, t, curve);
+        ec_fe_mul(&z, &z, &dz, curve);
+    }
+    fp_digit mask = (fp_digit)0 - swap;
+    ec_fe_cswap(&R[0].x, &R[1].x, mask, limbs);
+    ec_fe_cswap(&R[0].y, &R[1].y, mask, limbs);
+    m_del(uint8_t, kbits, bits);
+
+    // x = X0 / Z^2, Z = 0 once any addition degenerated
+    bool ok = !ec_fe_iszero(&z, curve);
+    if (ok)
+    {
+        ec_fe_invert(&z, &z, curve);
+        ec_fe_sqr(&z, &z, curve);
+        ec_fe_mul(&z, &R[0].x, &z, curve);
+        ec_fe_from_montgomery(&z, &z, curve);
+        ec_fe_to_fp(x, &z, curve);
+    }
+
+    fp_zero(kk);
+    fp_zero(k2);
+    fp_free(kk);
+    fp_free(k2);
+    return ok;
+}
+
+// rop = scalar1 * point1 + scalar2 * point2 in variable time, left in jacobian coordinates
+static void ec_point_shamirs_trick(ecc_jacobian_point_t *rop, ecc_point_t *point1, fp_int *scalar1, ecc_point_t *point2, fp_int *scalar2, ecc_curve_t *curve)
+{
+    ecc_odd_multiples_t *tables[2];
+    fp_int *scalars[2] = {scalar1, scalar2};
+
+    tables[0] = ec_point_odd_multiples(point1, curve);
+    tables[1] = ec_point_odd_multiples(point2, curve);
+
+    ec_point_mul_straus(rop, tables, scalars, 2, curve);
+
+    ec_point_odd_multiples_free(tables[0], curve);
+    ec_point_odd_multiples_free(tables[1], curve);
+}
+
+// window width minimizing the additions of the bucket method, (bits / c + 1) * (n + 2^c)
+static int ec_pippenger_window(size_t n, int bits)
+{
+    int best = 1;
+    size_t best_cost = (size_t)-1;
+
+    for (int c = 1; c <= ECC_MSM_MAX_WINDOW_BITS; c++)
+    {
+        size_t cost = (size_t)(bits / c + 1) * (n + ((size_t)1 << c));
+        if (cost < best_cost)
+        {
+            best = c;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+// rop = sum of scalars[i] * points[i] with the bucket method (Pippenger), in variable time, for public scalars only:
+// every window of c bits adds each point to the bucket of its digit, then sums the buckets weighted by their digit
+static void ec_point_mul_pippenger(ecc_jacobian_point_t *rop, ecc_point_t **points, fp_int **scalars, size_t n, ecc_curve_t *curve)
+{
+    size_t limbs = curve->limbs;
+    int bits = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        int b = fp_count_bits(scalars[i]);
+        if (b > bits)
+        {
+            bits = b;
+        }
+    }
+
+    int c = ec_pippenger_window(n, bits);
+    int len = bits / c + 1;
+    size_t buckets = (size_t)1 << (c - 1);
+    int16_t *digits = m_new(int16_t, n * len);
+    fp_digit *affine = m_new(fp_digit, n * 2 * limbs);
+    fp_digit *bucket = m_new(fp_digit, buckets * 3 * limbs);
+    bool *used = m_new(bool, buckets);
+    ecc_jacobian_point_t P, B, S, W;
+
+    // digits and montgomery affine coordinates of every term, negating the digits of negative scalars
+    for (size_t i = 0; i < n; i++)
+    {
+        int16_t *d = &digits[i * len];
+
+        memset(d, 0, len * sizeof(int16_t));
+        ec_scalar_signed_digits(d, scalars[i], c);
+        if (scalars[i]->sign == FP_NEG)
+        {
+            for (int j = 0; j < len; j++)
+            {
+                d[j] = -d[j];
+            }
+        }
+
+        ec_point_to_jacobian(&P, points[i], curve);
+        ec_fe_store(&affine[i * 2 * limbs], &P.x, limbs);
+        ec_fe_store(&affine[(i * 2 + 1) * limbs], &P.y, limbs);
+    }
+
+    ec_jacobian_set_identity(rop, curve);
+    for (int window = len - 1; window >= 0; window--)
+    {
+        for (int j = 0; j < c && !ec_fe_iszero(&rop->z, curve); j++)
+        {
+            ec_jacobian_double(rop, rop, curve);
+        }
+
+        // bucket[|d| - 1] += sign(d) * points[i]
+        memset(used, 0, buckets * sizeof(bool));
+        for (size_t i = 0; i < n; i++)
+        {
+            int d = digits[i * len + window];
+            if (d == 0)
+            {
+                continue;
+            }
+
+            size_t b = (size_t)((d < 0 ? -d : d) - 1);
+            fp_digit *entry = &bucket[b * 3 * limbs];
+
+            ec_fe_load(&P.x, &affine[i * 2 * limbs], limbs);
+            ec_fe_load(&P.y, &affine[(i * 2 + 1) * limbs], limbs);
+            P.z = curve->one;
+            if (d < 0)
+            {
+                ec_fe_neg(&P.y, &P.y, curve);
+            }
+
+            if (used[b])
+            {
+                ec_fe_load(&B.x, entry, limbs);
+                ec_fe_load(&B.y, entry + limbs, limbs);
+                ec_fe_load(&B.z, entry + (2 * limbs), limbs);
+                ec_jacobian_add_mixed(&P, &B, &P, curve);
+            }
+            ec_fe_store(entry, &P.x, limbs);
+            ec_fe_store(entry + limbs, &P.y, limbs);
+            ec_fe_store(entry + (2 * limbs), &P.z, limbs);
+            used[b] = true;
+        }
+
+        // W = sum of (b + 1) * bucket[b] as running sums from the top bucket
+        ec_jacobian_set_identity(&S, curve);
+        ec_jacobian_set_identity(&W, curve);
+        for (size_t b = buckets; b-- > 0;)
+        {
+            if (used[b])
+            {
+                fp_digit *entry = &bucket[b * 3 * limbs];
+                ec_fe_load(&B.x, entry, limbs);
+                ec_fe_load(&B.y, entry + limbs, limbs);
+                ec_fe_load(&B.z, entry + (2 * limbs), limbs);
+                ec_jacobian_add(&S, &S, &B, curve);
+            }
+            ec_jacobian_add(&W, &W, &S, curve);
+        }
+        ec_jacobian_add(rop, rop, &W, curve);
+    }
+
+    m_del(int16_t, digits, n * len);
+    m_del(fp_digit, affine, n * 2 * limbs);
+    m_del(fp_digit, bucket, buckets * 3 * limbs);
+    m_del(bool, used, buckets);
+}
+
+// rop = sum of scalars[i] * points[i] in variable time, for public scalars only,
+// interleaved wNAF (Straus) for a few terms, the bucket method (Pippenger) for many
+static void ec_point_msm(ecc_point_t *rop, ecc_point_t **points, fp_int **scalars, size_t n, ecc_curve_t *curve)
+{
+    ecc_point_t **P = m_new(ecc_point_t *, n);
+    fp_int **k = m_new(fp_int *, n);
+    ecc_jacobian_point_t R;
+    size_t m = 0;
+
+    // drop the terms that are the identity element
+    for (size_t i = 0; i < n; i++)
+    {
+        if ((fp_cmp_d(points[i]->x, 0) == FP_EQ && fp_cmp_d(points[i]->y, 0) == FP_EQ) || fp_iszero(scalars[i]) == FP_YES)
+        {
+            continue;
+        }
+        P[m] = points[i];
+        k[m++] = scalars[i];
+    }
+
+    if (m > ECC_MSM_STRAUS_MAX)
+    {
+        ec_point_mul_pippenger(&R, P, k, m, curve);
+    }
+    else
+    {
+        ecc_odd_multiples_t **tables = m_new(ecc_odd_multiples_t *, m);
+        for (size_t i = 0; i < m; i++)
+        {
+            tables[i] = ec_point_odd_multiples(P[i], curve);
+        }
+
+        ec_point_mul_straus(&R, tables, k, m, curve);
+
+        for (size_t i = 0; i < m; i++)
+        {
+            ec_point_odd_multiples_free(tables[i], curve);
+        }
+        m_del(ecc_odd_multiples_t *, tables, m);
+    }
+
+    // a single inversion to get back the affine coordinates
+    ec_jacobian_to_affine(rop, &R, curve);
+
+    m_del(ecc_point_t *, P, n);
+    m_del(fp_int *, k, n);
+}
+
+// e = digest as integer, truncated to the bits of the order (digest is computed as hex in ecdsa.py)
+static void ecdsa_digest(fp_int *e, unsigned char *msg, size_t msg_len, ecc_curve_t *curve)
+{
+    fp_read_radix(e, (const char *)msg, 16);
+
+    int orderBits = fp_count_bits(curve->q);
+    int digestBits = msg_len * 4;
+
+    if (digestBits > orderBits)
+    {
+        fp_div_2d(e, digestBits - orderBits, e, NULL);
+    }
+}
+
+// R[x] mod q == r checked in jacobian coordinates, as X == x * Z^2 for every x < p with x = r mod q
+static bool ecdsa_check_x(ecc_jacobian_point_t *R, fp_int *r, ecc_curve_t *curve)
+{
+    if (ec_fe_iszero(&R->z, curve) || r->sign == FP_NEG || fp_cmp(r, curve->q) != FP_LT)
+    {
+        return false;
+    }
+
+    fp_int *x = fp_alloc_scratch();
+    ec_fe_t zz, t;
+    bool equal = false;
+
+    ec_fe_sqr(&zz, &R->z, curve);
+    fp_copy(r, x);
+    while (!equal && fp_cmp(x, curve->p) == FP_LT)
+    {
+        ec_fe_from_fp(&t, x, curve);
+        ec_fe_to_montgomery(&t, &t, curve);
+        ec_fe_mul(&t, &t, &zz, curve);
+        equal = ec_fe_equal(&t, &R->x, curve);
+        fp_add(x, curve->q, x);
+    }
+
+    fp_free(x);
+    return equal;
+}
+
+static void ecdsa_s(ecdsa_signature_t *sig, unsigned char *msg, size_t msg_len, fp_int *d, fp_int *k, ecc_curve_t *curve)
+{
+    fp_int *e = fp_alloc_scratch();
+    fp_int *kinv = fp_alloc_scratch();
+
+    // R = k * G, r = R[x]
+    ecc_point_t *R = m_new_obj(ecc_point_t);
+    R->x = fp_alloc_scratch();
+    R->y = fp_alloc_scratch();
+
+    ec_point_mul(R, curve->g, k, curve);
+    fp_copy(R->x, sig->r);
+    fp_mod(sig->r, curve->q, sig->r);
+
+    ecdsa_digest(e, msg, msg_len, curve);
+
+    // s = (k^-1 * (e + d * r)) mod n
+    fp_invmod(k, curve->q, kinv);
+    fp_zero(sig->s);
+
+    fp_mul(d, sig->r, sig->s);
+    fp_add(sig->s, e, sig->s);
+    fp_mul(sig->s, kinv, sig->s);
+    fp_mod(sig->s, curve->q, sig->s);
+
+    fp_free(e);
+    fp_free(kinv);
+
+    fp_free(R->x);
+    fp_free(R->y);
+    m_del_obj(ecc_point_t, R);
+}
+
+// 1 <= r, s < q
+static bool ecdsa_signature_in_range(ecdsa_signature_t *sig, ecc_curve_t *curve)
+{
+    return fp_cmp_d(sig->r, 0) == FP_GT && fp_cmp(sig->r, curve->q) == FP_LT && fp_cmp_d(sig->s, 0) == FP_GT && fp_cmp(sig->s, curve->q) == FP_LT;
+}
+
+// qtable are the odd multiples of Q if cached (PublicKey), NULL to compute them
+static int ecdsa_v(ecdsa_signature_t *sig, unsigned char *msg, size_t msg_len, ecc_point_t *Q, ecc_odd_multiples_t *qtable, ecc_curve_t *curve)
+{
+    // fp_invmod doesn't return on s = 0
+    if (!ecdsa_signature_in_range(sig, curve))
+    {
+        return false;
+    }
+
+    fp_int *e = fp_alloc_scratch();
+    fp_int *w = fp_alloc_scratch();
+    fp_int *u1 = fp_alloc_scratch();
+    fp_int *u2 = fp_alloc_scratch();
+    fp_int *scalars[2] = {u1, u2};
+    ecc_odd_multiples_t *tables[2];
+
+    ecc_jacobian_point_t R;
+
+    ecdsa_digest(e, msg, msg_len, curve);
+
+    fp_invmod(sig->s, curve->q, w);
+    fp_mul(e, w, u1);
+    fp_mod(u1, curve->q, u1);
+    fp_mul(sig->r, w, u2);
+    fp_mod(u2, curve->q, u2);
+
+    // R = u1 * G + u2 * Q
+    tables[0] = ec_generator_odd_multiples(curve);
+    tables[1] = (qtable != NULL) ? qtable : ec_point_odd_multiples(Q, curve);
+    ec_point_mul_straus(&R, tables, scalars, 2, curve);
+
+    int equal = ecdsa_check_x(&R, sig->r, curve);
+
+    if (qtable == NULL)
+    {
+        ec_point_odd_multiples_free(tables[1], curve);
+    }
+
+    fp_free(e);
+    fp_free(w);
+    fp_free(u1);
+    fp_free(u2);
+
+    return equal;
+}
+
+// w[i] = s[i]^-1 mod q sharing a single inversion, zero for signatures out of range
+static void ecdsa_batch_invert_s(fp_int **w, ecdsa_signature_t **sigs, size_t n, ecc_curve_t *curve)
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        if (ecdsa_signature_in_range(sigs[i], curve))
+        {
+            fp_copy(sigs[i]->s, w[i]);
+        }
+        else
+        {
+            fp_zero(w[i]);
+        }
+    }
+
+    if (fp_invmod_batch(w, w, n, curve->q) != FP_OKAY)
+    {
+        // q is not prime, invert one by one
+        for (size_t i = 0; i < n; i++)
+        {
+            if (fp_iszero(w[i]) == FP_NO)
+            {
+                fp_invmod(sigs[i]->s, curve->q, w[i]);
+            }
+        }
+    }
+}
+
+// valid[i] = ecdsa verification of (sigs[i], e[i], Q[i]), sharing the inversions of s, without final inversions
+static void ecdsa_v_batch(bool *valid, ecdsa_signature_t **sigs, fp_int **e, ecc_point_t **Q, size_t n, ecc_curve_t *curve)
+{
+    fp_int **w = m_new(fp_int *, n);
+    fp_int *u1 = fp_alloc_scratch();
+    fp_int *u2 = fp_alloc_scratch();
+    ecc_jacobian_point_t R;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        w[i] = fp_alloc();
+    }
+    ecdsa_batch_invert_s(w, sigs, n, curve);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        valid[i] = false;
+        if (fp_iszero(w[i]) == FP_YES)
+        {
+            continue;
+        }
+
+        // u1 = e * w, u2 = r * w, R = u1 * G + u2 * Q
+        fp_mulmod(e[i], w[i], curve->q, u1);
+        fp_mulmod(sigs[i]->r, w[i], curve->q, u2);
+        ec_point_shamirs_trick(&R, curve->g, u1, Q[i], u2, curve);
+        valid[i] = ecdsa_check_x(&R, sigs[i]->r, curve);
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        fp_free(w[i]);
+    }
+    m_del(fp_int *, w, n);
+    fp_free(u1);
+    fp_free(u2);
+}
+
+static mp_obj_t point_equal(mp_obj_t point1, mp_obj_t point2)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
+    }
+    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
+    }
+
+    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
+    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
+    return mp_obj_new_bool(ec_point_equal(p1->ecc_point, p2->ecc_point));
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(point_equal_obj, point_equal);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_equal_obj, MP_ROM_PTR(&point_equal_obj));
+
+static mp_obj_t point_double(mp_obj_t point, mp_obj_t curve)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *p = MP_OBJ_TO_PTR(point);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+
+    mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+    ec_point_double(pr->ecc_point, p->ecc_point, c->ecc_curve);
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(point_double_obj, point_double);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_double_obj, MP_ROM_PTR(&point_double_obj));
+
+static mp_obj_t point_add(mp_obj_t point1, mp_obj_t point2, mp_obj_t curve)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
+    }
+    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
+    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+
+    mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+    ec_point_add(pr->ecc_point, p1->ecc_point, p2->ecc_point, c->ecc_curve);
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_3(point_add_obj, point_add);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_add_obj, MP_ROM_PTR(&point_add_obj));
+
+static mp_obj_t point_sub(mp_obj_t point1, mp_obj_t point2, mp_obj_t curve)
+{
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
+    }
+    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
+    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+
+    // -point2.y % curve.p
+    fp_int *p2_y_fp_int = fp_alloc_scratch();
+
+    fp_copy(p2->ecc_point->y, p2_y_fp_int);
+
+    fp_neg(p2->ecc_point->y, p2->ecc_point->y);
+    fp_mod(p2->ecc_point->y, c->ecc_curve->p, p2->ecc_point->y);
+
+    mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+    ec_point_add(pr->ecc_point, p1->ecc_point, p2->ecc_point, c->ecc_curve);
+
+    // restore point.y
+    fp_copy(p2_y_fp_int, p2->ecc_point->y);
+
+    fp_free(p2_y_fp_int);
+
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_3(point_sub_obj, point_sub);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_sub_obj, MP_ROM_PTR(&point_sub_obj));
+
+static mp_obj_t point_mul_helper(mp_obj_t point, mp_obj_t scalar, mp_obj_t curve, bool public_scalar)
+{
+    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+    }
+    if (!MP_OBJ_IS_INT(scalar))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 2, mp_obj_get_type_str(scalar));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *p = MP_OBJ_TO_PTR(point);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+
+    fp_int *s_fp_int = fp_alloc_scratch();
+
+    mp_fp_for_int(scalar, s_fp_int);
+
+    mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+    if (public_scalar)
+    {
+        ec_point_mul_wnaf(pr->ecc_point, p->ecc_point, s_fp_int, c->ecc_curve);
+    }
     else
     {
-        if ((attr == MP_QSTR_p || attr == MP_QSTR_a || attr == MP_QSTR_b || attr == MP_QSTR_q || attr == MP_QSTR_gx || attr == MP_QSTR_gy) && !MP_OBJ_IS_INT(dest[1]))
-        {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT, mp_obj_get_type_str(dest[1]));
-        }
-        else if (attr == MP_QSTR_G && !MP_OBJ_IS_TYPE(dest[1], &point_type))
-        {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_BUT, mp_obj_get_type_str(dest[1]));
-        }
-        else if ((attr == MP_QSTR_name || attr == MP_QSTR_oid) && !MP_OBJ_IS_STR_OR_BYTES(dest[1]))
-        {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(dest[1]));
-        }
+        ec_point_mul(pr->ecc_point, p->ecc_point, s_fp_int, c->ecc_curve);
+    }
 
-        if (attr == MP_QSTR_p)
-        {
-            mp_fp_for_int(dest[1], self->ecc_curve->p);
-        }
-        else if (attr == MP_QSTR_a)
-        {
-            mp_fp_for_int(dest[1], self->ecc_curve->a);
-        }
-        else if (attr == MP_QSTR_b)
-        {
-            mp_fp_for_int(dest[1], self->ecc_curve->b);
-        }
-        else if (attr == MP_QSTR_q)
+    fp_free(s_fp_int);
+
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static mp_obj_t point_mul(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    /*
+        point (Point): The point to multiply
+        scalar (int): The scalar
+        curve (Curve): The curve of the point
+        public (bool): The scalar is not secret, use the faster variable time wNAF instead of the ladder
+    */
+
+    fp_scratch_enter();
+
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_point, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_scalar, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_curve, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_public, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false}},
+    };
+
+    struct
+    {
+        mp_arg_val_t point, scalar, curve, public;
+    } args;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    return point_mul_helper(args.point.u_obj, args.scalar.u_obj, args.curve.u_obj, args.public.u_bool);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_KW(point_mul_obj, 3, point_mul);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_mul_obj, MP_ROM_PTR(&point_mul_obj));
+
+static mp_obj_t normalize_batch(mp_obj_t points, mp_obj_t curve)
+{
+    /*
+        points (list): (X, Y, Z) jacobian coordinates, x = X / Z^2 and y = Y / Z^3, Z = 0 for the point at infinity
+        curve (Curve): The curve of the points
+    */
+
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
+    }
+
+    size_t n = 0;
+    mp_obj_t *items = NULL;
+    mp_obj_get_array(points, &n, &items);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        mp_obj_t *coords = NULL;
+        mp_obj_get_array_fixed_n(items[i], 3, &coords);
+        for (size_t j = 0; j < 3; j++)
         {
-            mp_fp_for_int(dest[1], self->ecc_curve->q);
+            if (!MP_OBJ_IS_INT(coords[j]))
+            {
+                mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, j + 1, mp_obj_get_type_str(coords[j]));
+            }
         }
-        else if (attr == MP_QSTR_G)
-        {
-            mp_point_t *other = MP_OBJ_TO_PTR(dest[1]);
+    }
 
-            self->ecc_curve = m_new_obj(ecc_curve_t);
-            self->ecc_curve->p = fp_alloc();
-            self->ecc_curve->a = fp_alloc();
-            self->ecc_curve->b = fp_alloc();
-            self->ecc_curve->q = fp_alloc();
-            self->ecc_curve->g = m_new_obj(ecc_point_t);
-            self->ecc_curve->g->x = fp_alloc();
-            self->ecc_curve->g->y = fp_alloc();
-
-            fp_copy(other->ecc_curve->p, self->ecc_curve->p);
-            fp_copy(other->ecc_curve->a, self->ecc_curve->a);
-            fp_copy(other->ecc_curve->b, self->ecc_curve->b);
-            fp_copy(other->ecc_curve->q, self->ecc_curve->q);
-            fp_copy(other->ecc_point->x, self->ecc_curve->g->x);
-            fp_copy(other->ecc_point->y, self->ecc_curve->g->y);
-        }
-        else if (attr == MP_QSTR_gx)
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+    size_t chunk = (n < FP_INVMOD_BATCH_CHUNK) ? n : FP_INVMOD_BATCH_CHUNK;
+    ecc_jacobian_point_t *J = m_new(ecc_jacobian_point_t, chunk);
+    ecc_jacobian_point_t **P = m_new(ecc_jacobian_point_t *, chunk);
+    ecc_point_t **R = m_new(ecc_point_t *, chunk);
+    for (size_t i = 0; i < chunk; i++)
+    {
+        P[i] = &J[i];
+    }
+    fp_int *t = fp_alloc_scratch();
+
+    mp_obj_t res = mp_obj_new_list(n, NULL);
+    mp_obj_t *res_items = ((mp_obj_list_t *)MP_OBJ_TO_PTR(res))->items;
+    for (size_t start = 0; start < n; start += chunk)
+    {
+        size_t count = ((n - start) < chunk) ? (n - start) : chunk;
+        for (size_t i = 0; i < count; i++)
         {
-            mp_fp_for_int(dest[1], self->ecc_curve->g->x);
+            mp_obj_t *coords = NULL;
+            mp_obj_get_array_fixed_n(items[start + i], 3, &coords);
+            ec_fe_t *coord[3] = {&P[i]->x, &P[i]->y, &P[i]->z};
+            for (size_t j = 0; j < 3; j++)
+            {
+                mp_fp_for_int(coords[j], t);
+                fp_mod(t, c->ecc_curve->p, t);
+                ec_fe_from_fp(coord[j], t, c->ecc_curve);
+                ec_fe_to_montgomery(coord[j], coord[j], c->ecc_curve);
+            }
+
+            mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+            R[i] = pr->ecc_point;
+            res_items[start + i] = MP_OBJ_FROM_PTR(pr);
         }
-        else if (attr == MP_QSTR_gy)
+
+        ec_jacobian_to_affine_batch(R, P, count, c->ecc_curve);
+    }
+
+    fp_free(t);
+    m_del(ecc_jacobian_point_t, J, chunk);
+    m_del(ecc_jacobian_point_t *, P, chunk);
+    m_del(ecc_point_t *, R, chunk);
+
+    return res;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(normalize_batch_obj, normalize_batch);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_normalize_batch_obj, MP_ROM_PTR(&normalize_batch_obj));
+
+static mp_obj_t msm(mp_obj_t points_in, mp_obj_t scalars_in, mp_obj_t curve)
+{
+    /*
+        points (list): The points
+        scalars (list): The int multiplying each point, public
+        curve (Curve): The curve of the points
+    */
+
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+    }
+
+    size_t n = 0, n_scalars = 0;
+    mp_obj_t *points = NULL;
+    mp_obj_t *scalars = NULL;
+    mp_obj_get_array(points_in, &n, &points);
+    mp_obj_get_array(scalars_in, &n_scalars, &scalars);
+    if (n != n_scalars)
+    {
+        mp_raise_ValueError(ERROR_MSM_LENGTH);
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (!MP_OBJ_IS_TYPE(points[i], &point_type))
         {
-            mp_fp_for_int(dest[1], self->ecc_curve->g->y);
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_BUT, mp_obj_get_type_str(points[i]));
         }
-        else if (attr == MP_QSTR_name)
+        if (!MP_OBJ_IS_INT(scalars[i]))
         {
-            mp_buffer_info_t bufinfo_name;
-            mp_get_buffer_raise(dest[1], &bufinfo_name, MP_BUFFER_READ);
-            vstr_init(&self->ecc_curve->name, bufinfo_name.len);
-            vstr_add_strn(&self->ecc_curve->name, bufinfo_name.buf, bufinfo_name.len);
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT, mp_obj_get_type_str(scalars[i]));
         }
-        else if (attr == MP_QSTR_oid)
-        {
-            mp_buffer_info_t bufinfo_oid;
-            mp_get_buffer_raise(dest[1], &bufinfo_oid, MP_BUFFER_READ);
+    }
 
-            if (MP_OBJ_IS_TYPE(dest[1], &mp_type_bytes))
-            {
-                vstr_init(&self->ecc_curve->oid, bufinfo_oid.len);
-                vstr_add_strn(&self->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
-            }
-            else if (MP_OBJ_IS_STR(dest[1]))
-            {
-                vstr_unhexlify(&self->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
-            }
-        }
-        else
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+    ecc_point_t **P = m_new(ecc_point_t *, n);
+    fp_int **k = m_new(fp_int *, n);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        P[i] = ((mp_point_t *)MP_OBJ_TO_PTR(points[i]))->ecc_point;
+        k[i] = fp_alloc();
+        mp_fp_for_int(scalars[i], k[i]);
+    }
+
+    mp_point_t *pr = new_point_init_shared(c->ecc_curve);
+    ec_point_msm(pr->ecc_point, P, k, n, c->ecc_curve);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        fp_free(k[i]);
+    }
+    m_del(ecc_point_t *, P, n);
+    m_del(fp_int *, k, n);
+
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_3(msm_obj, msm);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_msm_obj, MP_ROM_PTR(&msm_obj));
+
+static mp_obj_t signature(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    fp_scratch_enter();
+
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_r, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_s, MP_ARG_OBJ, {.u_obj = mp_const_none}}};
+
+    struct
+    {
+        mp_arg_val_t r, s;
+    } args;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    mp_ecdsa_signature_t *signature = m_new_obj(mp_ecdsa_signature_t);
+    signature->base.type = &signature_type;
+    for (size_t i = 0; i < n_args; i++)
+    {
+        if (!MP_OBJ_IS_INT(pos_args[i]))
         {
-            return;
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, mp_obj_get_type_str(pos_args[i]), i);
         }
-        dest[0] = MP_OBJ_NULL; // indicate success
     }
+
+    signature->ecdsa_signature = m_new_obj(ecdsa_signature_t);
+    signature->ecdsa_signature->r = fp_alloc();
+    signature->ecdsa_signature->s = fp_alloc();
+
+    mp_fp_for_int(args.r.u_obj, signature->ecdsa_signature->r);
+    mp_fp_for_int(args.s.u_obj, signature->ecdsa_signature->s);
+
+    return MP_OBJ_FROM_PTR(signature);
 }
 
-static const mp_rom_map_elem_t curve_locals_dict_table[] = {
-    {MP_ROM_QSTR(MP_QSTR_p), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_a), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_b), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_q), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_G), MP_ROM_PTR(mp_const_none)},
-    {MP_ROM_QSTR(MP_QSTR_gx), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_gy), MP_ROM_INT(0)},
-    {MP_ROM_QSTR(MP_QSTR_name), MP_ROM_PTR(mp_const_none)},
-    {MP_ROM_QSTR(MP_QSTR_oid), MP_ROM_PTR(mp_const_none)},
-};
+static MP_DEFINE_CONST_FUN_OBJ_KW(signature_obj, 2, signature);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_signature_obj, MP_ROM_PTR(&signature_obj));
 
-static MP_DEFINE_CONST_DICT(curve_locals_dict, curve_locals_dict_table);
+static mp_obj_t ecdsa_sign(size_t n_args, const mp_obj_t *args)
+{
+    fp_scratch_enter();
 
-MP_DEFINE_CONST_OBJ_TYPE(
-    curve_type,
-    MP_QSTR_Curve,
-    MP_TYPE_FLAG_NONE,
-    print, curve_print,
-    binary_op, curve_binary_op,
-    attr, curve_attr,
-    locals_dict, &curve_locals_dict);
+    (void)n_args;
+    mp_obj_t msg = args[0];
+    mp_obj_t d = args[1];
+    mp_obj_t k = args[2];
+    mp_obj_t curve = args[3];
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(msg, &bufinfo, MP_BUFFER_READ);
+    if (!MP_OBJ_IS_INT(d))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 2, mp_obj_get_type_str(d));
+    }
+    if (!MP_OBJ_IS_INT(k))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 3, mp_obj_get_type_str(k));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 4, mp_obj_get_type_str(curve));
+    }
+
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+
+    fp_int *d_fp_int = fp_alloc_scratch();
+    fp_int *k_fp_int = fp_alloc_scratch();
+
+    mp_fp_for_int(d, d_fp_int);
+    mp_fp_for_int(k, k_fp_int);
+
+    mp_ecdsa_signature_t *sr = m_new_obj(mp_ecdsa_signature_t);
+    sr->base.type = &signature_type;
+
+    sr->ecdsa_signature = m_new_obj(ecdsa_signature_t);
+    sr->ecdsa_signature->r = fp_alloc();
+    sr->ecdsa_signature->s = fp_alloc();
+
+    ecdsa_s(sr->ecdsa_signature, bufinfo.buf, bufinfo.len, d_fp_int, k_fp_int, c->ecc_curve);
+
+    fp_free(d_fp_int);
+    fp_free(k_fp_int);
+
+    return MP_OBJ_FROM_PTR(sr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ecdsa_sign_obj, 4, 4, ecdsa_sign);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdsa_sign_obj, MP_ROM_PTR(&ecdsa_sign_obj));
+
+static mp_obj_t ecdsa_verify(size_t n_args, const mp_obj_t *args)
+{
+    fp_scratch_enter();
+
+    (void)n_args;
+    mp_obj_t signature = args[0];
+    mp_obj_t msg = args[1];
+    mp_obj_t Q = args[2];
+    mp_obj_t curve = args[3];
+
+    if (!MP_OBJ_IS_TYPE(signature, &signature_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_SIGNATURE_AT_BUT, 1, mp_obj_get_type_str(signature));
+    }
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(msg, &bufinfo, MP_BUFFER_READ);
+    if (!MP_OBJ_IS_TYPE(Q, &point_type) && !MP_OBJ_IS_TYPE(Q, &public_key_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_OR_PUBLIC_KEY_AT_BUT, 3, mp_obj_get_type_str(Q));
+    }
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 4, mp_obj_get_type_str(curve));
+    }
+
+    mp_ecdsa_signature_t *s = MP_OBJ_TO_PTR(signature);
+    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+    if (MP_OBJ_IS_TYPE(Q, &public_key_type))
+    {
+        // the cached odd multiples are in the montgomery domain of the curve of the key
+        mp_public_key_t *pk = MP_OBJ_TO_PTR(Q);
+        if (!ec_curve_equal(pk->point->ecc_curve, c->ecc_curve))
+        {
+            mp_raise_ValueError(ERROR_CURVE_OF_PUBLIC_KEY_NOT_EQUAL);
+        }
+        return mp_obj_new_bool(ecdsa_v(s->ecdsa_signature, bufinfo.buf, bufinfo.len, pk->point->ecc_point, pk->odd, c->ecc_curve));
+    }
 
-static mp_obj_t curve(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+    mp_point_t *q = MP_OBJ_TO_PTR(Q);
+    return mp_obj_new_bool(ecdsa_v(s->ecdsa_signature, bufinfo.buf, bufinfo.len, q->ecc_point, NULL, c->ecc_curve));
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ecdsa_verify_obj, 4, 4, ecdsa_verify);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdsa_verify_obj, MP_ROM_PTR(&ecdsa_verify_obj));
+
+static mp_obj_t ecdsa_verify_batch(mp_obj_t items_in, mp_obj_t curve_in)
 {
     /*
-        Currently only curves in Weierstrass form (y^2 = x^3 + ax + b (mod p))
+        items (list): (Signature, digest, Point) tuples, as the args of ecdsa_verify
+        curve (Curve): The curve of the points
 
-        p (int): The value of math p in the curve equation
-        a (int): The value of math a in the curve equation
-        b (int): The value of math b in the curve equation
-        q (int): The order of the base point of the curve
-        gx (int): The x coordinate of the base point of the curve
-        gy (int): The y coordinate of the base point of the curve
-        name (str): The name of the curve
-        oid (str/bytes): The object identifier of the curve
+        Returns a list with the bool of ecdsa_verify for each item
     */
 
-    static const mp_arg_t allowed_args[] = {
-        {MP_QSTR_p, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_a, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_b, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_q, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_gx, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_gy, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_name, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_oid, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none}},
-    };
-
-    struct
-    {
-        mp_arg_val_t p, a, b, q, gx, gy, name, oid;
-    } args;
-    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+    fp_scratch_enter();
 
-    mp_curve_t *curve = m_new_obj(mp_curve_t);
-    curve->base.type = &curve_type;
-    curve->ecc_curve = m_new_obj(ecc_curve_t);
-    curve->ecc_curve->p = fp_alloc();
-    curve->ecc_curve->a = fp_alloc();
-    curve->ecc_curve->b = fp_alloc();
-    curve->ecc_curve->q = fp_alloc();
-    curve->ecc_curve->g = m_new_obj(ecc_point_t);
-    curve->ecc_curve->g->x = fp_alloc();
-    curve->ecc_curve->g->y = fp_alloc();
-
-    vstr_init(&curve->ecc_curve->name, 0);
-    vstr_init(&curve->ecc_curve->oid, 0);
-    for (size_t i = 0; i < n_args; i++)
+    if (!MP_OBJ_IS_TYPE(curve_in, &curve_type))
     {
-        if (!MP_OBJ_IS_INT(pos_args[i]))
-        {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, mp_obj_get_type_str(pos_args[i]), i);
-        }
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve_in));
     }
+    ecc_curve_t *curve = ((mp_curve_t *)MP_OBJ_TO_PTR(curve_in))->ecc_curve;
 
-    mp_fp_for_int(args.p.u_obj, curve->ecc_curve->p);
-    mp_fp_for_int(args.a.u_obj, curve->ecc_curve->a);
-    mp_fp_for_int(args.b.u_obj, curve->ecc_curve->b);
-    mp_fp_for_int(args.q.u_obj, curve->ecc_curve->q);
-    mp_fp_for_int(args.gx.u_obj, curve->ecc_curve->g->x);
-    mp_fp_for_int(args.gy.u_obj, curve->ecc_curve->g->y);
+    size_t n = 0;
+    mp_obj_t *items = NULL;
+    mp_obj_get_array(items_in, &n, &items);
 
-    if (args.name.u_obj != mp_const_none)
+    for (size_t i = 0; i < n; i++)
     {
-        if (!MP_OBJ_IS_STR_OR_BYTES(args.name.u_obj))
+        mp_obj_t *item = NULL;
+        mp_obj_get_array_fixed_n(items[i], 3, &item);
+        if (!MP_OBJ_IS_TYPE(item[0], &signature_type))
         {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(args.name.u_obj));
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_SIGNATURE_AT_BUT, 1, mp_obj_get_type_str(item[0]));
         }
-        else
+        if (!MP_OBJ_IS_TYPE(item[2], &point_type))
         {
-            mp_buffer_info_t bufinfo_name;
-            mp_get_buffer_raise(args.name.u_obj, &bufinfo_name, MP_BUFFER_READ);
-            vstr_add_strn(&curve->ecc_curve->name, bufinfo_name.buf, bufinfo_name.len);
+            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 3, mp_obj_get_type_str(item[2]));
         }
     }
 
-    if (args.oid.u_obj != mp_const_none)
+    // the signatures are verified ECDSA_BATCH_CHUNK at a time to bound the memory in use
+    size_t chunk = (n < ECDSA_BATCH_CHUNK) ? n : ECDSA_BATCH_CHUNK;
+    bool *valid = m_new(bool, chunk);
+    ecdsa_signature_t **sigs = m_new(ecdsa_signature_t *, chunk);
+    ecc_point_t **Q = m_new(ecc_point_t *, chunk);
+    fp_int **e = m_new(fp_int *, chunk);
+    for (size_t i = 0; i < chunk; i++)
     {
-        if (!MP_OBJ_IS_STR_OR_BYTES(args.oid.u_obj))
+        e[i] = fp_alloc();
+    }
+
+    mp_obj_t result = mp_obj_new_list(n, NULL);
+    mp_obj_t *result_items = ((mp_obj_list_t *)MP_OBJ_TO_PTR(result))->items;
+    for (size_t start = 0; start < n; start += chunk)
+    {
+        size_t count = ((n - start) < chunk) ? (n - start) : chunk;
+        for (size_t i = 0; i < count; i++)
         {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_STR_BYTES_BUT, mp_obj_get_type_str(args.oid.u_obj));
+            mp_obj_t *item = NULL;
+            mp_buffer_info_t bufinfo;
+            mp_obj_get_array_fixed_n(items[start + i], 3, &item);
+            mp_get_buffer_raise(item[1], &bufinfo, MP_BUFFER_READ);
+            sigs[i] = ((mp_ecdsa_signature_t *)MP_OBJ_TO_PTR(item[0]))->ecdsa_signature;
+            Q[i] = ((mp_point_t *)MP_OBJ_TO_PTR(item[2]))->ecc_point;
+            ecdsa_digest(e[i], bufinfo.buf, bufinfo.len, curve);
         }
-        else
-        {
-            mp_buffer_info_t bufinfo_oid;
-            mp_get_buffer_raise(args.oid.u_obj, &bufinfo_oid, MP_BUFFER_READ);
 
-            if (MP_OBJ_IS_TYPE(args.oid.u_obj, &mp_type_bytes))
-            {
-                vstr_init(&curve->ecc_curve->oid, bufinfo_oid.len);
-                vstr_add_strn(&curve->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
-            }
-            else if (MP_OBJ_IS_STR(args.oid.u_obj))
-            {
-                vstr_unhexlify(&curve->ecc_curve->oid, bufinfo_oid.buf, bufinfo_oid.len);
-            }
+        ecdsa_v_batch(valid, sigs, e, Q, count, curve);
+        for (size_t i = 0; i < count; i++)
+        {
+            result_items[start + i] = mp_obj_new_bool(valid[i]);
         }
     }
 
-    return MP_OBJ_FROM_PTR(curve);
+    for (size_t i = 0; i < chunk; i++)
+    {
+        fp_free(e[i]);
+    }
+    m_del(bool, valid, chunk);
+    m_del(ecdsa_signature_t *, sigs, chunk);
+    m_del(ecc_point_t *, Q, chunk);
+    m_del(fp_int *, e, chunk);
+    return result;
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_KW(curve_obj, 6, curve);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_curve_obj, MP_ROM_PTR(&curve_obj));
+static MP_DEFINE_CONST_FUN_OBJ_2(ecdsa_verify_batch_obj, ecdsa_verify_batch);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdsa_verify_batch_obj, MP_ROM_PTR(&ecdsa_verify_batch_obj));
 
-///////////////////////////////////// Point ////////////////////////////////////
-
-static bool ec_point_equal(ecc_point_t *p1, ecc_point_t *p2)
+static mp_obj_t ecdh(mp_obj_t d, mp_obj_t Q, mp_obj_t curve)
 {
-    // check x coords
-    if (fp_cmp(p1->x, p2->x) != FP_EQ)
+    /*
+        d (int): The private scalar, in [1, q - 1]
+        Q (Point or PublicKey): The public point of the peer, checked to be on the curve
+        curve (Curve): The curve of the point
+        returns the x coordinate of d * Q as big endian bytes of the length of p
+    */
+
+    fp_scratch_enter();
+
+    if (!MP_OBJ_IS_INT(d))
     {
-        return false;
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 1, mp_obj_get_type_str(d));
     }
-    // check y coords
-    if (fp_cmp(p1->y, p2->y) != FP_EQ)
+    if (!MP_OBJ_IS_TYPE(Q, &point_type) && !MP_OBJ_IS_TYPE(Q, &public_key_type))
     {
-        return false;
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_OR_PUBLIC_KEY_AT_BUT, 2, mp_obj_get_type_str(Q));
     }
-    return true;
-}
-
-static void ec_point_double(ecc_point_t *rop, ecc_point_t *op, ecc_curve_t *curve)
-{
-    if (fp_cmp_d(op->x, 0) == FP_EQ && fp_cmp_d(op->y, 0) == FP_EQ)
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
     {
-        fp_set(rop->x, 0);
-        fp_set(rop->y, 0);
-        return;
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
     }
 
-    fp_int *numer = fp_alloc();
-    fp_int *denom = fp_alloc();
-    fp_int *lambda = fp_alloc();
+    ecc_curve_t *c = ((mp_curve_t *)MP_OBJ_TO_PTR(curve))->ecc_curve;
+    fp_int *k = fp_alloc_scratch();
+    fp_int *x = fp_alloc_scratch();
+    ecc_point_t P;
+    P.x = fp_alloc_scratch();
+    P.y = fp_alloc_scratch();
 
-    // calculate lambda
-    fp_mul(op->x, op->x, numer);
-    fp_mul_d(numer, 3, numer);
-    fp_add(numer, curve->a, numer);
-    fp_mul_d(op->y, 2, denom);
+    mp_fp_for_int(d, k);
+    bool valid = (fp_cmp_d(k, 0) == FP_GT && fp_cmp(k, c->q) == FP_LT);
 
-    // handle 2P = identity case
-    if (fp_invmod(denom, curve->p, denom) != FP_OKAY)
+    if (valid && MP_OBJ_IS_TYPE(Q, &public_key_type))
     {
-        fp_set(rop->x, 0);
-        fp_set(rop->y, 0);
-
-        fp_free(numer);
-        fp_free(denom);
-        fp_free(lambda);
-        return;
+        // already validated, and reduced, by the constructor
+        mp_public_key_t *pk = MP_OBJ_TO_PTR(Q);
+        if (!ec_curve_equal(pk->point->ecc_curve, c))
+        {
+            fp_free(k);
+            fp_free(x);
+            fp_free(P.x);
+            fp_free(P.y);
+            mp_raise_ValueError(ERROR_CURVE_OF_PUBLIC_KEY_NOT_EQUAL);
+        }
+        fp_copy(pk->point->ecc_point->x, P.x);
+        fp_copy(pk->point->ecc_point->y, P.y);
     }
-
-    fp_mul(numer, denom, lambda);
-    fp_mod(lambda, curve->p, lambda);
-
-    // calculate resulting x coord
-    fp_mul(lambda, lambda, rop->x);
-    fp_sub(rop->x, op->x, rop->x);
-    fp_sub(rop->x, op->x, rop->x);
-    fp_mod(rop->x, curve->p, rop->x);
-
-    // calculate resulting y coord
-    fp_sub(op->x, rop->x, rop->y);
-    fp_mul(lambda, rop->y, rop->y);
-    fp_sub(rop->y, op->y, rop->y);
-    fp_mod(rop->y, curve->p, rop->y);
-
-    fp_free(numer);
-    fp_free(denom);
-    fp_free(lambda);
-}
-
-static void ec_point_add(ecc_point_t *rop, ecc_point_t *op1, ecc_point_t *op2, ecc_curve_t *curve)
-{
-    // handle the identity element
-    if (fp_cmp_d(op1->x, 0) == FP_EQ && fp_cmp_d(op1->y, 0) == FP_EQ && fp_cmp_d(op2->x, 0) == FP_EQ && fp_cmp_d(op2->y, 0) == FP_EQ)
+    else if (valid)
     {
-        fp_set(rop->x, 0);
-        fp_set(rop->y, 0);
-        return;
+        mp_point_t *q = MP_OBJ_TO_PTR(Q);
+        fp_mod(q->ecc_point->x, c->p, P.x);
+        fp_mod(q->ecc_point->y, c->p, P.y);
     }
-    else if (fp_cmp_d(op1->x, 0) == FP_EQ && fp_cmp_d(op1->y, 0) == FP_EQ)
+    if (!valid)
     {
-        fp_copy(op2->x, rop->x);
-        fp_copy(op2->y, rop->y);
-        return;
+        fp_free(k);
+        fp_free(x);
+        fp_free(P.x);
+        fp_free(P.y);
+        mp_raise_ValueError(ERROR_ECDH_SCALAR_RANGE);
     }
-    else if (fp_cmp_d(op2->x, 0) == FP_EQ && fp_cmp_d(op2->y, 0) == FP_EQ)
+
+    // not the identity element, of order greater than 2 and on the curve
+    valid = fp_iszero(P.y) == FP_NO && ec_point_in_curve(&P, c);
+
+    // the co-Z ladder runs on k + h * q, the order of every point of the curve divides h * q
+    fp_int *m = fp_alloc_scratch();
+    bool order = ec_curve_order(m, c);
+    if (valid && (!order || !ec_point_mul_x_coz(x, &P, k, m, c)))
     {
-        fp_copy(op1->x, rop->x);
-        fp_copy(op1->y, rop->y);
-        return;
+        // no cofactor for q < 4 * sqrt(p), or an intermediate sum of the ladder was the identity,
+        // the generic ladder handles both
+        ecc_point_t R = {x, fp_alloc_scratch()};
+        ec_point_mul(&R, &P, k, c);
+        valid = !(fp_iszero(R.x) == FP_YES && fp_iszero(R.y) == FP_YES);
+        fp_free(R.y);
     }
+    fp_free(m);
 
-    if (ec_point_equal(op1, op2))
+    byte out[FP_SIZE * sizeof(fp_digit)];
+    int len = (fp_count_bits(c->p) + 7) / 8;
+    if (valid)
     {
-        ec_point_double(rop, op1, curve);
-        return;
+        memset(out, 0, len);
+        fp_to_unsigned_bin(x, &out[len - fp_unsigned_bin_size(x)]);
     }
 
-    // check if points sum to identity element
-    fp_int *negy = fp_alloc();
+    fp_zero(k);
+    fp_free(k);
+    fp_free(x);
+    fp_free(P.x);
+    fp_free(P.y);
 
-    fp_sub(curve->p, op2->y, negy);
-    if (fp_cmp(op1->x, op2->x) == FP_EQ && fp_cmp(op1->y, negy) == 0)
+    if (!valid)
     {
-        fp_set(rop->x, 0);
-        fp_set(rop->y, 0);
-
-        fp_free(negy);
-        return;
+        mp_raise_ValueError(ERROR_INVALID_PUBLIC_KEY);
     }
 
-    fp_int *xdiff = fp_alloc();
-    fp_int *ydiff = fp_alloc();
-    fp_int *lambda = fp_alloc();
-
-    // calculate lambda
-    fp_sub(op2->y, op1->y, ydiff);
-    fp_sub(op2->x, op1->x, xdiff);
-    fp_invmod(xdiff, curve->p, xdiff);
-    fp_mul(ydiff, xdiff, lambda);
-    fp_mod(lambda, curve->p, lambda);
+    mp_obj_t secret = mp_obj_new_bytes(out, len);
+    memset(out, 0, len);
+    return secret;
+}
 
-    // calculate resulting x coord
-    fp_mul(lambda, lambda, rop->x);
-    fp_sub(rop->x, op1->x, rop->x);
-    fp_sub(rop->x, op2->x, rop->x);
-    fp_mod(rop->x, curve->p, rop->x);
+static MP_DEFINE_CONST_FUN_OBJ_3(ecdh_obj, ecdh);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdh_obj, MP_ROM_PTR(&ecdh_obj));
 
-    // calculate resulting y coord
-    fp_sub(op1->x, rop->x, rop->y);
-    fp_mul(lambda, rop->y, rop->y);
-    fp_sub(rop->y, op1->y, rop->y);
-    fp_mod(rop->y, curve->p, rop->y);
+// field of curve25519, p = 2^255 - 19, in radix 2^25.5: ten signed limbs of 26 and 25 bits alternately,
+// limb i weighs 2^ceil(25.5 * i). the limbs are 32 bits so that each product is a single 32x32 -> 64
+// multiply, only the sums of products are 64 bits
+typedef struct _fe25519_t
+{
+    int32_t v[10];
+} fe25519_t;
 
-    fp_free(xdiff);
-    fp_free(ydiff);
-    fp_free(lambda);
-    fp_free(negy);
-}
+// width in bits of the limb i
+#define FE25519_BITS(i) (((i) & 1) ? 25 : 26)
 
-static void ec_point_mul(ecc_point_t *rop, ecc_point_t *point, fp_int scalar, ecc_curve_t *curve)
+// h = t with the limbs brought back in [-2^(bits - 1), 2^(bits - 1)], the carry out of the top limb
+// wraps around as 19, t up to 2^62 in magnitude
+static void fe25519_carry_wide(fe25519_t *h, int64_t *t)
 {
-    // handle the identity element
-    if (fp_cmp_d(point->x, 0) == FP_EQ && fp_cmp_d(point->y, 0) == FP_EQ)
+    int64_t c;
+
+    for (int i = 0; i < 10; i++)
     {
-        fp_set(rop->x, 0);
-        fp_set(rop->y, 0);
-        return;
+        int bits = FE25519_BITS(i);
+        c = (t[i] + ((int64_t)1 << (bits - 1))) >> bits;
+        t[i] -= c * ((int64_t)1 << bits);
+        t[(i + 1) % 10] += (i < 9) ? c : 19 * c;
     }
+    c = (t[0] + ((int64_t)1 << 25)) >> 26;
+    t[0] -= c * ((int64_t)1 << 26);
+    t[1] += c;
 
-    bool scalar_is_negative = false;
-    if (fp_cmp_d(&scalar, 2) == FP_EQ)
+    for (int i = 0; i < 10; i++)
     {
-        ec_point_double(rop, point, curve);
-        return;
+        h->v[i] = (int32_t)t[i];
     }
+}
 
-    if (fp_cmp_d(&scalar, 0) == FP_LT)
+static void fe25519_carry(fe25519_t *h)
+{
+    int64_t t[10];
+    for (int i = 0; i < 10; i++)
     {
-        scalar_is_negative = true;
+        t[i] = h->v[i];
     }
+    fe25519_carry_wide(h, t);
+}
 
-    fp_int *point_y_fp_int = fp_alloc();
-
-    if (scalar_is_negative)
+static void fe25519_add(fe25519_t *h, const fe25519_t *f, const fe25519_t *g)
+{
+    for (int i = 0; i < 10; i++)
     {
-        // copy point.y
-        fp_copy(point->y, point_y_fp_int);
-        // -point.y % curve.p
-        fp_neg(point->y, point->y);
-        fp_mod(point->y, curve->p, point->y);
-
-        // -scalar
-        fp_neg(&scalar, &scalar);
+        h->v[i] = f->v[i] + g->v[i];
     }
+}
 
-    ecc_point_t *R0 = m_new_obj(ecc_point_t);
-    R0->x = fp_alloc();
-    R0->y = fp_alloc();
-
-    ecc_point_t *R1 = m_new_obj(ecc_point_t);
-    R1->x = fp_alloc();
-    R1->y = fp_alloc();
-
-    ecc_point_t *tmp = m_new_obj(ecc_point_t);
-    tmp->x = fp_alloc();
-    tmp->y = fp_alloc();
-
-    fp_copy(point->x, R0->x);
-    fp_copy(point->y, R0->y);
+static void fe25519_sub(fe25519_t *h, const fe25519_t *f, const fe25519_t *g)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        h->v[i] = f->v[i] - g->v[i];
+    }
+}
 
-    ec_point_double(R1, point, curve);
+// h = f * g, operands may come straight out of one add or sub
+static void fe25519_mul(fe25519_t *h, const fe25519_t *f, const fe25519_t *g)
+{
+    int64_t t[19] = {0};
+    int32_t g2[10];
 
-    int dbits = fp_count_bits(&scalar), i;
-    for (i = dbits - 2; i >= 0; i--)
+    // two odd limbs sit half a bit low, their product counts twice
+    for (int j = 0; j < 10; j++)
+    {
+        g2[j] = (j & 1) ? 2 * g->v[j] : g->v[j];
+    }
+    for (int i = 0; i < 10; i++)
     {
-        if (fp_tstbit(scalar, i))
+        const int32_t *gi = (i & 1) ? g2 : g->v;
+        for (int j = 0; j < 10; j++)
         {
-            fp_copy(R0->x, tmp->x);
-            fp_copy(R0->y, tmp->y);
+            t[i + j] += (int64_t)f->v[i] * gi[j];
+        }
+    }
 
-            ec_point_add(R0, R1, tmp, curve);
+    // 2^255 = 19 mod p
+    for (int i = 0; i < 9; i++)
+    {
+        t[i] += 19 * t[i + 10];
+    }
+    fe25519_carry_wide(h, t);
+}
 
-            fp_copy(R1->x, tmp->x);
-            fp_copy(R1->y, tmp->y);
+// h = f^2 with the cross products counted once
+static void fe25519_sqr(fe25519_t *h, const fe25519_t *f)
+{
+    int64_t t[19] = {0};
+    int32_t f2[10];
 
-            ec_point_double(R1, tmp, curve);
-        }
-        else
+    for (int j = 0; j < 10; j++)
+    {
+        f2[j] = 2 * f->v[j];
+    }
+    for (int i = 0; i < 10; i++)
+    {
+        t[2 * i] += (int64_t)f->v[i] * ((i & 1) ? f2[i] : f->v[i]);
+        for (int j = i + 1; j < 10; j++)
         {
-            fp_copy(R1->x, tmp->x);
-            fp_copy(R1->y, tmp->y);
+            t[i + j] += (int64_t)f2[i] * ((i & j & 1) ? f2[j] : f->v[j]);
+        }
+    }
 
-            ec_point_add(R1, R0, tmp, curve);
+    for (int i = 0; i < 9; i++)
+    {
+        t[i] += 19 * t[i + 10];
+    }
+    fe25519_carry_wide(h, t);
+}
 
-            fp_copy(R0->x, tmp->x);
-            fp_copy(R0->y, tmp->y);
+static void fe25519_mul_small(fe25519_t *h, const fe25519_t *f, int32_t n)
+{
+    int64_t t[10];
+    for (int i = 0; i < 10; i++)
+    {
+        t[i] = (int64_t)f->v[i] * n;
+    }
+    fe25519_carry_wide(h, t);
+}
 
-            ec_point_double(R0, tmp, curve);
-        }
+// swap f and g if b, without branches
+static void fe25519_cswap(fe25519_t *f, fe25519_t *g, int32_t b)
+{
+    int32_t mask = -b;
+    for (int i = 0; i < 10; i++)
+    {
+        int32_t x = (f->v[i] ^ g->v[i]) & mask;
+        f->v[i] ^= x;
+        g->v[i] ^= x;
+    }
+}
+
+// t = f^(2^250 - 1) and z11 = f^11, the common head of the inversion and of the square roots
+static void fe25519_pow2250m1(fe25519_t *t, fe25519_t *z11, const fe25519_t *f)
+{
+    fe25519_t z2, z9, z2_5_0, z2_10_0, z2_20_0, z2_50_0, z2_100_0;
+
+    fe25519_sqr(&z2, f);
+    fe25519_sqr(t, &z2);
+    fe25519_sqr(t, t);
+    fe25519_mul(&z9, t, f);
+    fe25519_mul(z11, &z9, &z2);
+    fe25519_sqr(t, z11);
+    fe25519_mul(&z2_5_0, t, &z9);
+
+    // z2_n_0 = f^(2^n - 1)
+    *t = z2_5_0;
+    for (int i = 0; i < 5; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(&z2_10_0, t, &z2_5_0);
+    *t = z2_10_0;
+    for (int i = 0; i < 10; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(&z2_20_0, t, &z2_10_0);
+    *t = z2_20_0;
+    for (int i = 0; i < 20; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(t, t, &z2_20_0);
+    for (int i = 0; i < 10; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(&z2_50_0, t, &z2_10_0);
+    *t = z2_50_0;
+    for (int i = 0; i < 50; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(&z2_100_0, t, &z2_50_0);
+    *t = z2_100_0;
+    for (int i = 0; i < 100; i++)
+    {
+        fe25519_sqr(t, t);
+    }
+    fe25519_mul(t, t, &z2_100_0);
+    for (int i = 0; i < 50; i++)
+    {
+        fe25519_sqr(t, t);
     }
+    fe25519_mul(t, t, &z2_50_0);
+}
 
-    fp_copy(R0->x, rop->x);
-    fp_copy(R0->y, rop->y);
+// h = f^(p - 2) = f^-1, f^0 = 0 for f = 0
+static void fe25519_invert(fe25519_t *h, const fe25519_t *f)
+{
+    fe25519_t t, z11;
 
-    if (scalar_is_negative)
+    // f^(2^255 - 32) * f^11 = f^(2^255 - 21)
+    fe25519_pow2250m1(&t, &z11, f);
+    for (int i = 0; i < 5; i++)
     {
-        // restore point.y
-        fp_copy(point_y_fp_int, point->y);
-        // restore scalar
-        fp_neg(&scalar, &scalar);
+        fe25519_sqr(&t, &t);
     }
+    fe25519_mul(h, &t, &z11);
+}
 
-    fp_free(R0->x);
-    fp_free(R0->y);
-    m_del_obj(ecc_point_t, R0);
-
-    fp_free(R1->x);
-    fp_free(R1->y);
-    m_del_obj(ecc_point_t, R1);
+// h = f^((p - 5) / 8) = f^(2^252 - 3)
+static void fe25519_pow22523(fe25519_t *h, const fe25519_t *f)
+{
+    fe25519_t t, z11;
 
-    fp_free(tmp->x);
-    fp_free(tmp->y);
-    m_del_obj(ecc_point_t, tmp);
+    fe25519_pow2250m1(&t, &z11, f);
+    fe25519_sqr(&t, &t);
+    fe25519_sqr(&t, &t);
+    fe25519_mul(h, &t, f);
 }
 
-static void ec_point_shamirs_trick(ecc_point_t *rop, ecc_point_t *point1, fp_int scalar1, ecc_point_t *point2, fp_int scalar2, ecc_curve_t *curve)
+// h = the 255 low bits of s, little endian
+static void fe25519_from_bytes(fe25519_t *h, const byte *s)
 {
-    ecc_point_t *sum = m_new_obj(ecc_point_t);
-    sum->x = fp_alloc();
-    sum->y = fp_alloc();
-
-    ecc_point_t *tmp = m_new_obj(ecc_point_t);
-    tmp->x = fp_alloc();
-    tmp->y = fp_alloc();
+    int offset = 0;
+    for (int i = 0; i < 10; i++)
+    {
+        int bits = FE25519_BITS(i);
+        uint64_t word = 0;
+        for (int j = 0; j < 5 && (offset >> 3) + j < 32; j++)
+        {
+            word |= (uint64_t)s[(offset >> 3) + j] << (8 * j);
+        }
+        h->v[i] = (int32_t)((word >> (offset & 7)) & (((uint64_t)1 << bits) - 1));
+        offset += bits;
+    }
+}
 
-    ec_point_add(sum, point1, point2, curve);
+// s = h mod p in [0, p), little endian
+static void fe25519_to_bytes(byte *s, const fe25519_t *f)
+{
+    fe25519_t h = *f;
+    int32_t q;
 
-    int scalar1Bits = fp_count_bits(&scalar1);
-    int scalar2Bits = fp_count_bits(&scalar2);
-    int l = (scalar1Bits > scalar2Bits ? scalar1Bits : scalar2Bits) - 1;
+    fe25519_carry(&h);
 
-    if (fp_tstbit(scalar1, l) && fp_tstbit(scalar2, l))
-    {
-        fp_copy(sum->x, rop->x);
-        fp_copy(sum->y, rop->y);
-    }
-    else if (fp_tstbit(scalar1, l))
+    // q = 1 if h >= p else 0, by the carry of h + 19 out of 2^255
+    q = (19 * h.v[9] + ((int32_t)1 << 24)) >> 25;
+    for (int i = 0; i < 10; i++)
     {
-        fp_copy(point1->x, rop->x);
-        fp_copy(point1->y, rop->y);
+        q = (h.v[i] + q) >> FE25519_BITS(i);
     }
-    else if (fp_tstbit(scalar2, l))
+
+    // h - q * p = h + 19 * q - q * 2^255, the last carry is dropped
+    h.v[0] += 19 * q;
+    for (int i = 0; i < 9; i++)
     {
-        fp_copy(point2->x, rop->x);
-        fp_copy(point2->y, rop->y);
+        int32_t c = h.v[i] >> FE25519_BITS(i);
+        h.v[i + 1] += c;
+        h.v[i] -= c * ((int32_t)1 << FE25519_BITS(i));
     }
+    h.v[9] &= ((int32_t)1 << 25) - 1;
 
-    for (l = l - 1; l >= 0; l--)
+    memset(s, 0, 32);
+    int offset = 0;
+    for (int i = 0; i < 10; i++)
     {
-        fp_copy(rop->x, tmp->x);
-        fp_copy(rop->y, tmp->y);
-
-        ec_point_double(rop, tmp, curve);
-
-        fp_copy(rop->x, tmp->x);
-        fp_copy(rop->y, tmp->y);
-
-        if (fp_tstbit(scalar1, l) && fp_tstbit(scalar2, l))
-        {
-            ec_point_add(rop, tmp, sum, curve);
-        }
-        else if (fp_tstbit(scalar1, l))
-        {
-            ec_point_add(rop, tmp, point1, curve);
-        }
-        else if (fp_tstbit(scalar2, l))
+        uint64_t word = (uint64_t)(uint32_t)h.v[i] << (offset & 7);
+        for (int j = 0; j < 5 && (offset >> 3) + j < 32; j++)
         {
-            ec_point_add(rop, tmp, point2, curve);
+            s[(offset >> 3) + j] |= (byte)(word >> (8 * j));
         }
+        offset += FE25519_BITS(i);
     }
-
-    fp_free(sum->x);
-    fp_free(sum->y);
-    m_del_obj(ecc_point_t, sum);
-
-    fp_free(tmp->x);
-    fp_free(tmp->y);
-    m_del_obj(ecc_point_t, tmp);
 }
 
-static void ecdsa_s(ecdsa_signature_t *sig, unsigned char *msg, size_t msg_len, fp_int d, fp_int k, ecc_curve_t *curve)
+// out = X25519(k, u) of RFC 7748 with the x-only montgomery ladder, in constant time
+static void x25519_scalarmult(byte *out, const byte *scalar, const byte *point)
 {
-    fp_int *e = fp_alloc();
-    fp_int *kinv = fp_alloc();
-
-    // R = k * G, r = R[x]
-    ecc_point_t *R = m_new_obj(ecc_point_t);
-    R->x = fp_alloc();
-    R->y = fp_alloc();
-
-    ec_point_mul(R, curve->g, k, curve);
-    fp_copy(R->x, sig->r);
-    fp_mod(sig->r, curve->q, sig->r);
-
-    // convert digest to integer (digest is computed as hex in ecdsa.py)
-    fp_read_radix(e, (const char *)msg, 16);
-
-    int orderBits = fp_count_bits(curve->q);
-    int digestBits = msg_len * 4;
-
-    if (digestBits > orderBits)
+    byte k[32];
+    fe25519_t x1, x2, z2, x3, z3, a, aa, b, bb, e, c, d, da, cb;
+    int32_t swap = 0;
+
+    memcpy(k, scalar, 32);
+    k[0] &= 248;
+    k[31] &= 127;
+    k[31] |= 64;
+
+    fe25519_from_bytes(&x1, point);
+    memset(&x2, 0, sizeof(x2));
+    x2.v[0] = 1;
+    memset(&z2, 0, sizeof(z2));
+    x3 = x1;
+    z3 = x2;
+
+    for (int t = 254; t >= 0; t--)
     {
-        fp_int *n = fp_alloc();
-        fp_2expt(n, digestBits - orderBits);
-        fp_div(e, n, e, NULL);
-        fp_free(n);
+        int32_t bit = (k[t >> 3] >> (t & 7)) & 1;
+        swap ^= bit;
+        fe25519_cswap(&x2, &x3, swap);
+        fe25519_cswap(&z2, &z3, swap);
+        swap = bit;
+
+        fe25519_add(&a, &x2, &z2);
+        fe25519_sqr(&aa, &a);
+        fe25519_sub(&b, &x2, &z2);
+        fe25519_sqr(&bb, &b);
+        fe25519_sub(&e, &aa, &bb);
+        fe25519_add(&c, &x3, &z3);
+        fe25519_sub(&d, &x3, &z3);
+        fe25519_mul(&da, &d, &a);
+        fe25519_mul(&cb, &c, &b);
+
+        // x3 = (DA + CB)^2, z3 = x1 * (DA - CB)^2
+        fe25519_add(&x3, &da, &cb);
+        fe25519_sqr(&x3, &x3);
+        fe25519_sub(&z3, &da, &cb);
+        fe25519_sqr(&z3, &z3);
+        fe25519_mul(&z3, &z3, &x1);
+
+        // x2 = AA * BB, z2 = E * (AA + a24 * E)
+        fe25519_mul(&x2, &aa, &bb);
+        fe25519_mul_small(&z2, &e, 121665);
+        fe25519_add(&z2, &z2, &aa);
+        fe25519_mul(&z2, &z2, &e);
     }
+    fe25519_cswap(&x2, &x3, swap);
+    fe25519_cswap(&z2, &z3, swap);
 
-    // s = (k^-1 * (e + d * r)) mod n
-    fp_invmod(&k, curve->q, kinv);
-    fp_zero(sig->s);
-
-    fp_mul(&d, sig->r, sig->s);
-    fp_add(sig->s, e, sig->s);
-    fp_mul(sig->s, kinv, sig->s);
-    fp_mod(sig->s, curve->q, sig->s);
-
-    fp_free(e);
-    fp_free(kinv);
+    fe25519_invert(&z2, &z2);
+    fe25519_mul(&x2, &x2, &z2);
+    fe25519_to_bytes(out, &x2);
 
-    fp_free(R->x);
-    fp_free(R->y);
-    m_del_obj(ecc_point_t, R);
+    memset(k, 0, sizeof(k));
 }
 
-static int ecdsa_v(ecdsa_signature_t *sig, unsigned char *msg, size_t msg_len, ecc_point_t *Q, ecc_curve_t *curve)
+static mp_obj_t x25519(mp_obj_t scalar, mp_obj_t u)
 {
-    fp_int *e = fp_alloc();
-    fp_int *w = fp_alloc();
-    fp_int *u1 = fp_alloc();
-    fp_int *u2 = fp_alloc();
-
-    ecc_point_t *tmp = m_new_obj(ecc_point_t);
-    tmp->x = fp_alloc();
-    tmp->y = fp_alloc();
-
-    // convert digest to integer (digest is computed as hex in ecdsa.py)
-    fp_read_radix(e, (const char *)msg, 16);
+    fp_scratch_enter();
 
-    int orderBits = fp_count_bits(curve->q);
-    int digestBits = msg_len * 4;
+    mp_buffer_info_t bufinfo_scalar;
+    mp_buffer_info_t bufinfo_u;
+    mp_get_buffer_raise(scalar, &bufinfo_scalar, MP_BUFFER_READ);
+    mp_get_buffer_raise(u, &bufinfo_u, MP_BUFFER_READ);
 
-    if (digestBits > orderBits)
+    if (bufinfo_scalar.len != 32 || bufinfo_u.len != 32)
     {
-        fp_int *tmp_ = fp_alloc();
-        fp_2expt(tmp_, digestBits - orderBits);
-        fp_div(e, tmp_, e, NULL);
-        fp_free(tmp_);
+        mp_raise_ValueError(ERROR_X25519_LEN);
     }
 
-    fp_invmod(sig->s, curve->q, w);
-    fp_mul(e, w, u1);
-    fp_mod(u1, curve->q, u1);
-    fp_mul(sig->r, w, u2);
-    fp_mod(u2, curve->q, u2);
+    byte out[32];
+    x25519_scalarmult(out, (const byte *)bufinfo_scalar.buf, (const byte *)bufinfo_u.buf);
+    return mp_obj_new_bytes(out, sizeof(out));
+}
 
-    ec_point_shamirs_trick(tmp, curve->g, *u1, Q, *u2, curve);
-    fp_mod(tmp->x, curve->q, tmp->x);
+static MP_DEFINE_CONST_FUN_OBJ_2(x25519_obj, x25519);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_x25519_obj, MP_ROM_PTR(&x25519_obj));
 
-    int equal = (fp_cmp(tmp->x, sig->r) == FP_EQ);
+// sha-512 of FIPS 180-4, the hash of ed25519
+typedef struct _sha512_ctx_t
+{
+    uint64_t h[8];
+    uint64_t length;
+    byte buffer[128];
+    size_t used;
+} sha512_ctx_t;
+
+static const uint64_t sha512_iv[8] = {
+    0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL,
+};
 
-    fp_free(e);
-    fp_free(w);
-    fp_free(u1);
-    fp_free(u2);
+static const uint64_t sha512_k[80] = {
+    0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL, 0xe9b5dba58189dbbcULL,
+    0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL, 0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL,
+    0xd807aa98a3030242ULL, 0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+    0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL, 0xc19bf174cf692694ULL,
+    0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL, 0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL,
+    0x2de92c6f592b0275ULL, 0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+    0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL, 0xbf597fc7beef0ee4ULL,
+    0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL, 0x06ca6351e003826fULL, 0x142929670a0e6e70ULL,
+    0x27b70a8546d22ffcULL, 0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+    0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL, 0x92722c851482353bULL,
+    0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL, 0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL,
+    0xd192e819d6ef5218ULL, 0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+    0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL, 0x34b0bcb5e19b48a8ULL,
+    0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL, 0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL,
+    0x748f82ee5defb2fcULL, 0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+    0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL, 0xc67178f2e372532bULL,
+    0xca273eceea26619cULL, 0xd186b8c721c0c207ULL, 0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL,
+    0x06f067aa72176fbaULL, 0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+    0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL, 0x431d67c49c100d4cULL,
+    0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL, 0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL,
+};
 
-    fp_free(tmp->x);
-    fp_free(tmp->y);
-    m_del_obj(ecc_point_t, tmp);
-    return equal;
-}
+#define SHA512_ROTR(x, n) (((x) >> (n)) | ((x) << (64 - (n))))
 
-static mp_obj_t point_equal(mp_obj_t point1, mp_obj_t point2)
+static uint64_t sha512_load64(const byte *b)
 {
-    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
+        v = (v << 8) | b[i];
     }
-    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+    return v;
+}
+
+static void sha512_store64(byte *b, uint64_t v)
+{
+    for (int i = 7; i >= 0; i--)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
+        b[i] = (byte)v;
+        v >>= 8;
     }
-
-    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
-    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
-    return mp_obj_new_bool(ec_point_equal(p1->ecc_point, p2->ecc_point));
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_2(point_equal_obj, point_equal);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_equal_obj, MP_ROM_PTR(&point_equal_obj));
-
-static mp_obj_t point_double(mp_obj_t point, mp_obj_t curve)
+// one 128 bytes block, with the message schedule kept in a ring of 16 words
+static void sha512_compress(sha512_ctx_t *ctx, const byte *block)
 {
-    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    uint64_t w[16], v[8];
+
+    for (int i = 0; i < 16; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+        w[i] = sha512_load64(&block[i * 8]);
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    memcpy(v, ctx->h, sizeof(v));
+
+    for (int i = 0; i < 80; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
-    }
+        if (i >= 16)
+        {
+            uint64_t w15 = w[(i - 15) & 15], w2 = w[(i - 2) & 15];
+            uint64_t s0 = SHA512_ROTR(w15, 1) ^ SHA512_ROTR(w15, 8) ^ (w15 >> 7);
+            uint64_t s1 = SHA512_ROTR(w2, 19) ^ SHA512_ROTR(w2, 61) ^ (w2 >> 6);
+            w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+        }
 
-    mp_point_t *p = MP_OBJ_TO_PTR(point);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+        uint64_t e = v[4], a = v[0];
+        uint64_t t1 = v[7] + (SHA512_ROTR(e, 14) ^ SHA512_ROTR(e, 18) ^ SHA512_ROTR(e, 41)) + ((e & v[5]) ^ (~e & v[6])) + sha512_k[i] + w[i & 15];
+        uint64_t t2 = (SHA512_ROTR(a, 28) ^ SHA512_ROTR(a, 34) ^ SHA512_ROTR(a, 39)) + ((a & v[1]) ^ (a & v[2]) ^ (v[1] & v[2]));
 
-    mp_point_t *pr = new_point_init_copy(c);
-    ec_point_double(pr->ecc_point, p->ecc_point, c->ecc_curve);
-    return MP_OBJ_FROM_PTR(pr);
+        memmove(&v[1], &v[0], 7 * sizeof(uint64_t));
+        v[4] += t1;
+        v[0] = t1 + t2;
+    }
+
+    for (int i = 0; i < 8; i++)
+    {
+        ctx->h[i] += v[i];
+    }
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_2(point_double_obj, point_double);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_double_obj, MP_ROM_PTR(&point_double_obj));
+static void sha512_init(sha512_ctx_t *ctx)
+{
+    memcpy(ctx->h, sha512_iv, sizeof(ctx->h));
+    ctx->length = 0;
+    ctx->used = 0;
+}
 
-static mp_obj_t point_add(mp_obj_t point1, mp_obj_t point2, mp_obj_t curve)
+static void sha512_update(sha512_ctx_t *ctx, const byte *data, size_t len)
 {
-    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    ctx->length += len;
+    while (len > 0)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
+        size_t n = sizeof(ctx->buffer) - ctx->used;
+        if (n > len)
+        {
+            n = len;
+        }
+        memcpy(&ctx->buffer[ctx->used], data, n);
+        ctx->used += n;
+        data += n;
+        len -= n;
+        if (ctx->used == sizeof(ctx->buffer))
+        {
+            sha512_compress(ctx, ctx->buffer);
+            ctx->used = 0;
+        }
     }
-    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+}
+
+static void sha512_final(sha512_ctx_t *ctx, byte *digest)
+{
+    // 0x80, zeros, then the length in bits as a 128-bit big endian number
+    ctx->buffer[ctx->used++] = 0x80;
+    if (ctx->used > 112)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
+        memset(&ctx->buffer[ctx->used], 0, sizeof(ctx->buffer) - ctx->used);
+        sha512_compress(ctx, ctx->buffer);
+        ctx->used = 0;
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    memset(&ctx->buffer[ctx->used], 0, 112 - ctx->used);
+    sha512_store64(&ctx->buffer[112], ctx->length >> 61);
+    sha512_store64(&ctx->buffer[120], ctx->length << 3);
+    sha512_compress(ctx, ctx->buffer);
+
+    for (int i = 0; i < 8; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+        sha512_store64(&digest[i * 8], ctx->h[i]);
     }
-
-    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
-    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
-
-    mp_point_t *pr = new_point_init_copy(c);
-    ec_point_add(pr->ecc_point, p1->ecc_point, p2->ecc_point, c->ecc_curve);
-    return MP_OBJ_FROM_PTR(pr);
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_3(point_add_obj, point_add);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_add_obj, MP_ROM_PTR(&point_add_obj));
-
-static mp_obj_t point_sub(mp_obj_t point1, mp_obj_t point2, mp_obj_t curve)
+// edwards25519, -x^2 + y^2 = 1 + d * x^2 * y^2 over 2^255 - 19, in extended coordinates (X:Y:Z:T)
+// with x = X / Z, y = Y / Z and x * y = T / Z
+typedef struct _ed25519_point_t
 {
-    if (!MP_OBJ_IS_TYPE(point1, &point_type))
+    fe25519_t x;
+    fe25519_t y;
+    fe25519_t z;
+    fe25519_t t;
+} ed25519_point_t;
+
+// addend form of a point: (Y + X, Y - X, Z, 2 * d * T)
+typedef struct _ed25519_cached_t
+{
+    fe25519_t yplusx;
+    fe25519_t yminusx;
+    fe25519_t z;
+    fe25519_t t2d;
+} ed25519_cached_t;
+
+// little endian d = -121665 / 121666, 2 * d and sqrt(-1)
+static const byte ed25519_d[32] = {
+    0xa3, 0x78, 0x59, 0x13, 0xca, 0x4d, 0xeb, 0x75, 0xab, 0xd8, 0x41, 0x41, 0x4d, 0x0a, 0x70, 0x00,
+    0x98, 0xe8, 0x79, 0x77, 0x79, 0x40, 0xc7, 0x8c, 0x73, 0xfe, 0x6f, 0x2b, 0xee, 0x6c, 0x03, 0x52};
+static const byte ed25519_d2[32] = {
+    0x59, 0xf1, 0xb2, 0x26, 0x94, 0x9b, 0xd6, 0xeb, 0x56, 0xb1, 0x83, 0x82, 0x9a, 0x14, 0xe0, 0x00,
+    0x30, 0xd1, 0xf3, 0xee, 0xf2, 0x80, 0x8e, 0x19, 0xe7, 0xfc, 0xdf, 0x56, 0xdc, 0xd9, 0x06, 0x24};
+static const byte ed25519_sqrtm1[32] = {
+    0xb0, 0xa0, 0x0e, 0x4a, 0x27, 0x1b, 0xee, 0xc4, 0x78, 0xe4, 0x2f, 0xad, 0x06, 0x18, 0x43, 0x2f,
+    0xa7, 0xd7, 0xfb, 0x3d, 0x99, 0x00, 0x4d, 0x2b, 0x0b, 0xdf, 0xc1, 0x4f, 0x80, 0x24, 0x83, 0x2b};
+
+// big endian group order L = 2^252 + 27742317777372353535851937790883648493
+static const byte ed25519_order[32] = {
+    0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x14, 0xde, 0xf9, 0xde, 0xa2, 0xf7, 0x9c, 0xd6, 0x58, 0x12, 0x63, 0x1a, 0x5c, 0xf5, 0xd3, 0xed};
+
+// comb of the base point B: ed25519_base_comb[i][j] = (j + 1) * 16^(8 * i) * B in addend form with Z = 1,
+// packed as three little endian field elements
+static const byte ed25519_base_comb[8][8][3][32] = {
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point1));
-    }
-    if (!MP_OBJ_IS_TYPE(point2, &point_type))
+        {
+            {0x85, 0x3b, 0x8c, 0xf5, 0xc6, 0x93, 0xbc, 0x2f, 0x19, 0x0e, 0x8c, 0xfb, 0xc6, 0x2d, 0x93, 0xcf,
+             0xc2, 0x42, 0x3d, 0x64, 0x98, 0x48, 0x0b, 0x27, 0x65, 0xba, 0xd4, 0x33, 0x3a, 0x9d, 0xcf, 0x07},
+            {0x3e, 0x91, 0x40, 0xd7, 0x05, 0x39, 0x10, 0x9d, 0xb3, 0xbe, 0x40, 0xd1, 0x05, 0x9f, 0x39, 0xfd,
+             0x09, 0x8a, 0x8f, 0x68, 0x34, 0x84, 0xc1, 0xa5, 0x67, 0x12, 0xf8, 0x98, 0x92, 0x2f, 0xfd, 0x44},
+            {0x68, 0xaa, 0x7a, 0x87, 0x05, 0x12, 0xc9, 0xab, 0x9e, 0xc4, 0xaa, 0xcc, 0x23, 0xe8, 0xd9, 0x26,
+             0x8c, 0x59, 0x43, 0xdd, 0xcb, 0x7d, 0x1b, 0x5a, 0xa8, 0x65, 0x0c, 0x9f, 0x68, 0x7b, 0x11, 0x6f},
+        },
+        {
+            {0xd7, 0x71, 0x3c, 0x93, 0xfc, 0xe7, 0x24, 0x92, 0xb5, 0xf5, 0x0f, 0x7a, 0x96, 0x9d, 0x46, 0x9f,
+             0x02, 0x07, 0xd6, 0xe1, 0x65, 0x9a, 0xa6, 0x5a, 0x2e, 0x2e, 0x7d, 0xa8, 0x3f, 0x06, 0x0c, 0x59},
+            {0xa8, 0xd5, 0xb4, 0x42, 0x60, 0xa5, 0x99, 0x8a, 0xf6, 0xac, 0x60, 0x4e, 0x0c, 0x81, 0x2b, 0x8f,
+             0xaa, 0x37, 0x6e, 0xb1, 0x6b, 0x23, 0x9e, 0xe0, 0x55, 0x25, 0xc9, 0x69, 0xa6, 0x95, 0xb5, 0x6b},
+            {0x5f, 0x7a, 0x9b, 0xa5, 0xb3, 0xa8, 0xfa, 0x43, 0x78, 0xcf, 0x9a, 0x5d, 0xdd, 0x6b, 0xc1, 0x36,
+             0x31, 0x6a, 0x3d, 0x0b, 0x84, 0xa0, 0x0f, 0x50, 0x73, 0x0b, 0xa5, 0x3e, 0xb1, 0xf5, 0x1a, 0x70},
+        },
+        {
+            {0x30, 0x97, 0xee, 0x4c, 0xa8, 0xb0, 0x25, 0xaf, 0x8a, 0x4b, 0x86, 0xe8, 0x30, 0x84, 0x5a, 0x02,
+             0x32, 0x67, 0x01, 0x9f, 0x02, 0x50, 0x1b, 0xc1, 0xf4, 0xf8, 0x80, 0x9a, 0x1b, 0x4e, 0x16, 0x7a},
+            {0x65, 0xd2, 0xfc, 0xa4, 0xe8, 0x1f, 0x61, 0x56, 0x7d, 0xba, 0xc1, 0xe5, 0xfd, 0x53, 0xd3, 0x3b,
+             0xbd, 0xd6, 0x4b, 0x21, 0x1a, 0xf3, 0x31, 0x81, 0x62, 0xda, 0x5b, 0x55, 0x87, 0x15, 0xb9, 0x2a},
+            {0x89, 0xd8, 0xd0, 0x0d, 0x3f, 0x93, 0xae, 0x14, 0x62, 0xda, 0x35, 0x1c, 0x22, 0x23, 0x94, 0x58,
+             0x4c, 0xdb, 0xf2, 0x8c, 0x45, 0xe5, 0x70, 0xd1, 0xc6, 0xb4, 0xb9, 0x12, 0xaf, 0x26, 0x28, 0x5a},
+        },
+        {
+            {0x9f, 0x09, 0xfc, 0x8e, 0xb9, 0x51, 0x73, 0x28, 0x38, 0x25, 0xfd, 0x7d, 0xf4, 0xc6, 0x65, 0x67,
+             0x65, 0x92, 0x0a, 0xfb, 0x3d, 0x8d, 0x34, 0xca, 0x27, 0x87, 0xe5, 0x21, 0x03, 0x91, 0x0e, 0x68},
+            {0xbf, 0x18, 0x68, 0x05, 0x0a, 0x05, 0xfe, 0x95, 0xa9, 0xfa, 0x60, 0x56, 0x71, 0x89, 0x7e, 0x32,
+             0x73, 0x50, 0xa0, 0x06, 0xcd, 0xe3, 0xe8, 0xc3, 0x9a, 0xa4, 0x45, 0x74, 0x4c, 0x3f, 0x93, 0x27},
+            {0x09, 0xff, 0x76, 0xc4, 0xe9, 0xfb, 0x13, 0x5a, 0x72, 0xc1, 0x5c, 0x7b, 0x45, 0x39, 0x9e, 0x6e,
+             0x94, 0x44, 0x2b, 0x10, 0xf9, 0xdc, 0xdb, 0x5d, 0x2b, 0x3e, 0x55, 0x63, 0xbf, 0x0c, 0x9d, 0x7f},
+        },
+        {
+            {0x33, 0xbb, 0xa5, 0x08, 0x44, 0xbc, 0x12, 0xa2, 0x02, 0xed, 0x5e, 0xc7, 0xc3, 0x48, 0x50, 0x8d,
+             0x44, 0xec, 0xbf, 0x5a, 0x0c, 0xeb, 0x1b, 0xdd, 0xeb, 0x06, 0xe2, 0x46, 0xf1, 0xcc, 0x45, 0x29},
+            {0xba, 0xd6, 0x47, 0xa4, 0xc3, 0x82, 0x91, 0x7f, 0xb7, 0x29, 0x27, 0x4b, 0xd1, 0x14, 0x00, 0xd5,
+             0x87, 0xa0, 0x64, 0xb8, 0x1c, 0xf1, 0x3c, 0xe3, 0xf3, 0x55, 0x1b, 0xeb, 0x73, 0x7e, 0x4a, 0x15},
+            {0x85, 0x82, 0x2a, 0x81, 0xf1, 0xdb, 0xbb, 0xbc, 0xfc, 0xd1, 0xbd, 0xd0, 0x07, 0x08, 0x0e, 0x27,
+             0x2d, 0xa7, 0xbd, 0x1b, 0x0b, 0x67, 0x1b, 0xb4, 0x9a, 0xb6, 0x3b, 0x6b, 0x69, 0xbe, 0xaa, 0x43},
+        },
+        {
+            {0x31, 0x71, 0x15, 0x77, 0xeb, 0xee, 0x0c, 0x3a, 0x88, 0xaf, 0xc8, 0x00, 0x89, 0x15, 0x27, 0x9b,
+             0x36, 0xa7, 0x59, 0xda, 0x68, 0xb6, 0x65, 0x80, 0xbd, 0x38, 0xcc, 0xa2, 0xb6, 0x7b, 0xe5, 0x51},
+            {0xa4, 0x8c, 0x7d, 0x7b, 0xb6, 0x06, 0x98, 0x49, 0x39, 0x27, 0xd2, 0x27, 0x84, 0xe2, 0x5b, 0x57,
+             0xb9, 0x53, 0x45, 0x20, 0xe7, 0x5c, 0x08, 0xbb, 0x84, 0x78, 0x41, 0xae, 0x41, 0x4c, 0xb6, 0x38},
+            {0x71, 0x4b, 0xea, 0x02, 0x67, 0x32, 0xac, 0x85, 0x01, 0xbb, 0xa1, 0x41, 0x03, 0xe0, 0x70, 0xbe,
+             0x44, 0xc1, 0x3b, 0x08, 0x4b, 0xa2, 0xe4, 0x53, 0xe3, 0x61, 0x0d, 0x9f, 0x1a, 0xe9, 0xb8, 0x10},
+        },
+        {
+            {0xbf, 0xa3, 0x4e, 0x94, 0xd0, 0x5c, 0x1a, 0x6b, 0xd2, 0xc0, 0x9d, 0xb3, 0x3a, 0x35, 0x70, 0x74,
+             0x49, 0x2e, 0x54, 0x28, 0x82, 0x52, 0xb2, 0x71, 0x7e, 0x92, 0x3c, 0x28, 0x69, 0xea, 0x1b, 0x46},
+            {0xb1, 0x21, 0x32, 0xaa, 0x9a, 0x2c, 0x6f, 0xba, 0xa7, 0x23, 0xba, 0x3b, 0x53, 0x21, 0xa0, 0x6c,
+             0x3a, 0x2c, 0x19, 0x92, 0x4f, 0x76, 0xea, 0x9d, 0xe0, 0x17, 0x53, 0x2e, 0x5d, 0xdd, 0x6e, 0x1d},
+            {0xa2, 0xb3, 0xb8, 0x01, 0xc8, 0x6d, 0x83, 0xf1, 0x9a, 0xa4, 0x3e, 0x05, 0x47, 0x5f, 0x03, 0xb3,
+             0xf3, 0xad, 0x77, 0x58, 0xba, 0x41, 0x9c, 0x52, 0xa7, 0x90, 0x0f, 0x6a, 0x1c, 0xbb, 0x9f, 0x7a},
+        },
+        {
+            {0x8f, 0x3e, 0xdd, 0x04, 0x66, 0x59, 0xb7, 0x59, 0x2c, 0x70, 0x88, 0xe2, 0x77, 0x03, 0xb3, 0x6c,
+             0x23, 0xc3, 0xd9, 0x5e, 0x66, 0x9c, 0x33, 0xb1, 0x2f, 0xe5, 0xbc, 0x61, 0x60, 0xe7, 0x15, 0x09},
+            {0xd9, 0x34, 0x92, 0xf3, 0xed, 0x5d, 0xa7, 0xe2, 0xf9, 0x58, 0xb5, 0xe1, 0x80, 0x76, 0x3d, 0x96,
+             0xfb, 0x23, 0x3c, 0x6e, 0xac, 0x41, 0x27, 0x2c, 0xc3, 0x01, 0x0e, 0x32, 0xa1, 0x24, 0x90, 0x3a},
+            {0x1a, 0x91, 0xa2, 0xc9, 0xd9, 0xf5, 0xc1, 0xe7, 0xd7, 0xa7, 0xcc, 0x8b, 0x78, 0x71, 0xa3, 0xb8,
+             0x32, 0x2a, 0xb6, 0x0e, 0x19, 0x12, 0x64, 0x63, 0x95, 0x4e, 0xcc, 0x2e, 0x5c, 0x7c, 0x90, 0x26},
+        },
+    },
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 2, mp_obj_get_type_str(point2));
-    }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+        {
+            {0xe8, 0xc5, 0x85, 0x7b, 0x9f, 0xb6, 0x65, 0x87, 0xb2, 0xba, 0x68, 0xd1, 0x8b, 0x67, 0xf0, 0x6f,
+             0x9b, 0x0f, 0x33, 0x1d, 0x7c, 0xe7, 0x70, 0x3a, 0x7c, 0x8e, 0xaf, 0xb0, 0x51, 0x6d, 0x5f, 0x3a},
+            {0x5f, 0xac, 0x0d, 0xa6, 0x56, 0x87, 0x36, 0x61, 0x57, 0xdc, 0xab, 0xeb, 0x6a, 0x2f, 0xe0, 0x17,
+             0x7d, 0x0f, 0xce, 0x4c, 0x2d, 0x3f, 0x19, 0x7f, 0xf0, 0xdc, 0xec, 0x89, 0x77, 0x4a, 0x23, 0x20},
+            {0x52, 0xb2, 0x78, 0x71, 0xb6, 0x0d, 0xd2, 0x76, 0x60, 0xd1, 0x1e, 0xd5, 0xf9, 0x34, 0x1c, 0x07,
+             0x70, 0x11, 0xe4, 0xb3, 0x20, 0x4a, 0x2a, 0xf6, 0x66, 0xe3, 0xff, 0x3c, 0x35, 0x82, 0xd6, 0x7c},
+        },
+        {
+            {0xf3, 0xf4, 0xac, 0x68, 0x60, 0xcd, 0x65, 0xa6, 0xd3, 0xe3, 0xd7, 0x3c, 0x18, 0x2d, 0xd9, 0x42,
+             0xd9, 0x25, 0x60, 0x33, 0x9d, 0x38, 0x59, 0x57, 0xff, 0xd8, 0x2c, 0x2b, 0x3b, 0x25, 0xf0, 0x3e},
+            {0xb6, 0xfa, 0x87, 0xd8, 0x5b, 0xa4, 0xe1, 0x0b, 0x6e, 0x3b, 0x40, 0xba, 0x32, 0x6a, 0x84, 0x2a,
+             0x00, 0x60, 0x6e, 0xe9, 0x12, 0x10, 0x92, 0xd9, 0x43, 0x09, 0xdc, 0x3b, 0x86, 0xc8, 0x38, 0x28},
+            {0x30, 0x50, 0x46, 0x4a, 0xcf, 0xb0, 0x6b, 0xd1, 0xab, 0x77, 0xc5, 0x15, 0x41, 0x6b, 0x49, 0xfa,
+             0x9d, 0x41, 0xab, 0xf4, 0x8a, 0xae, 0xcf, 0x82, 0x12, 0x28, 0xa8, 0x06, 0xa6, 0xb8, 0xdc, 0x21},
+        },
+        {
+            {0xba, 0x31, 0x77, 0xbe, 0xfa, 0x00, 0x8d, 0x9a, 0x89, 0x18, 0x9e, 0x62, 0x7e, 0x60, 0x03, 0x82,
+             0x7f, 0xd9, 0xf3, 0x43, 0x37, 0x02, 0xcc, 0xb2, 0x8b, 0x67, 0x6f, 0x6c, 0xbf, 0x0d, 0x84, 0x5d},
+            {0xc8, 0x9f, 0x9d, 0x8c, 0x46, 0x04, 0x60, 0x5c, 0xcb, 0xa3, 0x2a, 0xd4, 0x6e, 0x09, 0x40, 0x25,
+             0x9c, 0x2f, 0xee, 0x12, 0x4c, 0x4d, 0x5b, 0x12, 0xab, 0x1d, 0xa3, 0x94, 0x81, 0xd0, 0xc3, 0x0b},
+            {0x8b, 0xe1, 0x9f, 0x30, 0x0d, 0x38, 0x6e, 0x70, 0xc7, 0x65, 0xe1, 0xb9, 0xa6, 0x2d, 0xb0, 0x6e,
+             0xab, 0x20, 0xae, 0x7d, 0x99, 0xba, 0xbb, 0x57, 0xdd, 0x96, 0xc1, 0x2a, 0x23, 0x76, 0x42, 0x3a},
+        },
+        {
+            {0xcb, 0x7e, 0x44, 0xdb, 0x72, 0xc1, 0xf8, 0x3b, 0xbd, 0x2d, 0x28, 0xc6, 0x1f, 0xc4, 0xcf, 0x5f,
+             0xfe, 0x15, 0xaa, 0x75, 0xc0, 0xff, 0xac, 0x80, 0xf9, 0xa9, 0xe1, 0x24, 0xe8, 0xc9, 0x70, 0x07},
+            {0xfa, 0x84, 0x70, 0x8a, 0x2c, 0x43, 0x42, 0x4b, 0x45, 0xe5, 0xb9, 0xdf, 0xe3, 0x19, 0x8a, 0x89,
+             0x5d, 0xe4, 0x58, 0x9c, 0x21, 0x00, 0x9f, 0xbe, 0xd1, 0xeb, 0x6d, 0xa1, 0xce, 0x77, 0xf1, 0x1f},
+            {0xfd, 0xb5, 0xb5, 0x45, 0x9a, 0xd9, 0x61, 0xcf, 0x24, 0x79, 0x3a, 0x1b, 0xe9, 0x84, 0x09, 0x86,
+             0x89, 0x3e, 0x3e, 0x30, 0x19, 0x09, 0x30, 0xe7, 0x1e, 0x0b, 0x50, 0x41, 0xfd, 0x64, 0xf2, 0x39},
+        },
+        {
+            {0xe1, 0x7b, 0x09, 0xfe, 0xab, 0x4a, 0x9b, 0xd1, 0x29, 0x19, 0xe0, 0xdf, 0xe1, 0xfc, 0x6d, 0xa4,
+             0xff, 0xf1, 0xa6, 0x2c, 0x94, 0x08, 0xc9, 0xc3, 0x4e, 0xf1, 0x35, 0x2c, 0x27, 0x21, 0xc6, 0x65},
+            {0x9c, 0xe2, 0xe7, 0xdb, 0x17, 0x34, 0xad, 0xa7, 0x9c, 0x13, 0x9c, 0x2b, 0x6a, 0x37, 0x94, 0xbd,
+             0xa9, 0x7b, 0x59, 0x93, 0x8e, 0x1b, 0xe9, 0xa0, 0x40, 0x98, 0x88, 0x68, 0x34, 0xd7, 0x12, 0x17},
+            {0xdd, 0x93, 0x31, 0xce, 0xf8, 0x89, 0x2b, 0xe7, 0xbb, 0xc0, 0x25, 0xa1, 0x56, 0x33, 0x10, 0x4d,
+             0x83, 0xfe, 0x1c, 0x2e, 0x3d, 0xa9, 0x19, 0x04, 0x72, 0xe2, 0x9c, 0xb1, 0x0a, 0x80, 0xf9, 0x22},
+        },
+        {
+            {0xac, 0xfd, 0x6e, 0x9a, 0xdd, 0x9f, 0x02, 0x42, 0x41, 0x49, 0xa5, 0x34, 0xbe, 0xce, 0x12, 0xb9,
+             0x7b, 0xf3, 0xbd, 0x87, 0xb9, 0x64, 0x0f, 0x64, 0xb4, 0xca, 0x98, 0x85, 0xd3, 0xa4, 0x71, 0x41},
+            {0xcb, 0xf8, 0x9e, 0x3e, 0x8a, 0x36, 0x5a, 0x60, 0x15, 0x47, 0x50, 0xa5, 0x22, 0xc0, 0xe9, 0xe3,
+             0x8f, 0x24, 0x24, 0x5f, 0xb0, 0x48, 0x3d, 0x55, 0xe5, 0x26, 0x76, 0x64, 0xcd, 0x16, 0xf4, 0x13},
+            {0x8c, 0x4c, 0xc9, 0x99, 0xaa, 0x58, 0x27, 0xfa, 0x07, 0xb8, 0x00, 0xb0, 0x6f, 0x6f, 0x00, 0x23,
+             0x92, 0x53, 0xda, 0xad, 0xdd, 0x91, 0xd2, 0xfb, 0xab, 0xd1, 0x4b, 0x57, 0xfa, 0x14, 0x82, 0x50},
+        },
+        {
+            {0xd6, 0x03, 0xd0, 0x53, 0xbb, 0x15, 0x1a, 0x46, 0x65, 0xc9, 0xf3, 0xbc, 0x88, 0x28, 0x10, 0xb2,
+             0x5a, 0x3a, 0x68, 0x6c, 0x75, 0x76, 0xc5, 0x27, 0x47, 0xb4, 0x6c, 0xc8, 0xa4, 0x58, 0x77, 0x3a},
+            {0x4b, 0xfe, 0xd6, 0x3e, 0x15, 0x69, 0x02, 0xc2, 0xc4, 0x77, 0x1d, 0x51, 0x39, 0x67, 0x5a, 0xa6,
+             0x94, 0xaf, 0x14, 0x2c, 0x46, 0x26, 0xde, 0xcb, 0x4b, 0xa7, 0xab, 0x6f, 0xec, 0x60, 0xf9, 0x22},
+            {0x76, 0x50, 0xae, 0x93, 0xf6, 0x11, 0x81, 0x54, 0xa6, 0x54, 0xfd, 0x1d, 0xdf, 0x21, 0xae, 0x1d,
+             0x65, 0x5e, 0x11, 0xf3, 0x90, 0x8c, 0x24, 0x12, 0x94, 0xf4, 0xe7, 0x8d, 0x5f, 0xd1, 0x9f, 0x5d},
+        },
+        {
+            {0x1e, 0x52, 0xd7, 0xee, 0x2a, 0x4d, 0x24, 0x3f, 0x15, 0x96, 0x2e, 0x43, 0x28, 0x90, 0x3a, 0x8e,
+             0xd4, 0x16, 0x9c, 0x2e, 0x77, 0xba, 0x64, 0xe1, 0xd8, 0x98, 0xeb, 0x47, 0xfa, 0x87, 0xc1, 0x3b},
+            {0x7f, 0x72, 0x63, 0x6d, 0xd3, 0x08, 0x14, 0x03, 0x33, 0xb5, 0xc7, 0xd7, 0xef, 0x9a, 0x37, 0x6a,
+             0x4b, 0xe2, 0xae, 0xcc, 0xc5, 0x8f, 0xe1, 0xa9, 0xd3, 0xbe, 0x8f, 0x4f, 0x91, 0x35, 0x2f, 0x33},
+            {0x0c, 0xc2, 0x86, 0xea, 0x15, 0x01, 0x47, 0x6d, 0x25, 0xd1, 0x46, 0x6c, 0xcb, 0xb7, 0x8a, 0x99,
+             0x88, 0x01, 0x66, 0x3a, 0xb5, 0x32, 0x78, 0xd7, 0x03, 0xba, 0x6f, 0x90, 0xce, 0x81, 0x0d, 0x45},
+        },
+    },
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+        {
+            {0x15, 0xf5, 0xd1, 0x77, 0xe7, 0x65, 0x2a, 0xcd, 0xf1, 0x60, 0xaa, 0x8f, 0x87, 0x91, 0x89, 0x54,
+             0xe5, 0x06, 0xbc, 0xda, 0xbc, 0x3b, 0xb7, 0xb1, 0xfb, 0xc9, 0x7c, 0xa9, 0xcb, 0x78, 0x48, 0x65},
+            {0xfe, 0xb0, 0xf6, 0x8d, 0xc7, 0x8e, 0x13, 0x51, 0x1b, 0xf5, 0x75, 0xe5, 0x89, 0xda, 0x97, 0x53,
+             0xb9, 0xf1, 0x7a, 0x71, 0x1d, 0x7a, 0x20, 0x09, 0x50, 0xd6, 0x20, 0x2b, 0xba, 0xfd, 0x02, 0x21},
+            {0xa1, 0xe6, 0x5c, 0x05, 0x05, 0xe4, 0x9e, 0x96, 0x29, 0xad, 0x51, 0x12, 0x68, 0xa7, 0xbc, 0x36,
+             0x15, 0xa4, 0x7d, 0xaa, 0x17, 0xf5, 0x1a, 0x3a, 0xba, 0xb2, 0xec, 0x29, 0xdb, 0x25, 0xd7, 0x0a},
+        },
+        {
+            {0x85, 0x6f, 0x05, 0x9b, 0x0c, 0xbc, 0xc7, 0xfe, 0xd7, 0xff, 0xf5, 0xe7, 0x68, 0x52, 0x7d, 0x53,
+             0xfa, 0xae, 0x12, 0x43, 0x62, 0xc6, 0xaf, 0x77, 0xd9, 0x9f, 0x39, 0x02, 0x53, 0x5f, 0x67, 0x4f},
+            {0x57, 0x24, 0x4e, 0x83, 0xb1, 0x67, 0x42, 0xdc, 0xc5, 0x1b, 0xce, 0x70, 0xb5, 0x44, 0x75, 0xb6,
+             0xd7, 0x5e, 0xd1, 0xf7, 0x0b, 0x7a, 0xf0, 0x1a, 0x50, 0x36, 0xa0, 0x71, 0xfb, 0xcf, 0xef, 0x4a},
+            {0x1e, 0x17, 0x15, 0x04, 0x36, 0x36, 0x2d, 0xc3, 0x3b, 0x48, 0x98, 0x89, 0x11, 0xef, 0x2b, 0xcd,
+             0x10, 0x51, 0x94, 0xd0, 0xad, 0x6e, 0x0a, 0x87, 0x61, 0x65, 0xa8, 0xa2, 0x72, 0xbb, 0xcc, 0x0b},
+        },
+        {
+            {0x96, 0x12, 0xfe, 0x50, 0x4c, 0x5e, 0x6d, 0x18, 0x7e, 0x9f, 0xe8, 0xfe, 0x82, 0x7b, 0x39, 0xe0,
+             0xb0, 0x31, 0x70, 0x50, 0xc5, 0xf6, 0xc7, 0x3b, 0xc2, 0x37, 0x8f, 0x10, 0x69, 0xfd, 0x78, 0x66},
+            {0xc8, 0xa9, 0xb1, 0xea, 0x2f, 0x96, 0x5e, 0x18, 0xcd, 0x7d, 0x14, 0x65, 0x35, 0xe6, 0xe7, 0x86,
+             0xf2, 0x6d, 0x5b, 0xbb, 0x31, 0xe0, 0x92, 0xb0, 0x3e, 0xb7, 0xd6, 0x59, 0xab, 0xf0, 0x24, 0x40},
+            {0xc2, 0x63, 0x68, 0x63, 0x31, 0xfa, 0x86, 0x15, 0xf2, 0x33, 0x2d, 0x57, 0x48, 0x8c, 0xf6, 0x07,
+             0xfc, 0xae, 0x9e, 0x78, 0x9f, 0xcc, 0x73, 0x4f, 0x01, 0x47, 0xad, 0x8e, 0x10, 0xe2, 0x42, 0x2d},
+        },
+        {
+            {0x93, 0x75, 0x53, 0x0f, 0x0d, 0x7b, 0x71, 0x21, 0x4c, 0x06, 0x1e, 0x13, 0x0b, 0x69, 0x4e, 0x91,
+             0x9f, 0xe0, 0x2a, 0x75, 0xae, 0x87, 0xb6, 0x1b, 0x6e, 0x3c, 0x42, 0x9b, 0xa7, 0xf3, 0x0b, 0x42},
+            {0x9b, 0xd2, 0xdf, 0x94, 0x15, 0x13, 0xf5, 0x97, 0x6a, 0x4c, 0x3f, 0x31, 0x5d, 0x98, 0x55, 0x61,
+             0x10, 0x50, 0x45, 0x08, 0x07, 0x3f, 0xa1, 0xeb, 0x22, 0xd3, 0xd2, 0xb8, 0x08, 0x26, 0x6b, 0x67},
+            {0x47, 0x2b, 0x5b, 0x1c, 0x65, 0xba, 0x38, 0x81, 0x80, 0x1b, 0x1b, 0x31, 0xec, 0xb6, 0x71, 0x86,
+             0xb0, 0x35, 0x31, 0xbc, 0xb1, 0x0c, 0xff, 0x7b, 0xe0, 0xf1, 0x0c, 0x9c, 0xfa, 0x2f, 0x5d, 0x74},
+        },
+        {
+            {0x6a, 0x4e, 0xd3, 0x21, 0x57, 0xdf, 0x36, 0x60, 0xd0, 0xb3, 0x7b, 0x99, 0x27, 0x88, 0xdb, 0xb1,
+             0xfa, 0x6a, 0x75, 0xc8, 0xc3, 0x09, 0xc2, 0xd3, 0x39, 0xc8, 0x1d, 0x4c, 0xe5, 0x5b, 0xe1, 0x06},
+            {0xbd, 0xc8, 0xc9, 0x2b, 0x1e, 0x5a, 0x52, 0xbf, 0x81, 0x9d, 0x47, 0x26, 0x08, 0x26, 0x5b, 0xea,
+             0xdb, 0x55, 0x01, 0xdf, 0x0e, 0xc7, 0x11, 0xd5, 0xd0, 0xf5, 0x0c, 0x96, 0xeb, 0x3c, 0xe2, 0x1a},
+            {0x4a, 0x99, 0x32, 0x19, 0x87, 0x5d, 0x72, 0x5b, 0xb0, 0xda, 0xb1, 0xce, 0xb5, 0x1c, 0x35, 0x32,
+             0x05, 0xca, 0xb7, 0xda, 0x49, 0x15, 0xc4, 0x7d, 0xf7, 0xc1, 0x8e, 0x27, 0x61, 0xd8, 0xde, 0x58},
+        },
+        {
+            {0xa8, 0xc9, 0xc2, 0xb6, 0xa8, 0x5b, 0xfb, 0x2d, 0x8c, 0x59, 0x2c, 0xf5, 0x8e, 0xef, 0xee, 0x48,
+             0x73, 0x15, 0x2d, 0xf1, 0x07, 0x91, 0x80, 0x33, 0xd8, 0x5b, 0x1d, 0x53, 0x6b, 0x69, 0xba, 0x08},
+            {0x5c, 0xc5, 0x66, 0xf2, 0x93, 0x37, 0x17, 0xd8, 0x49, 0x4e, 0x45, 0xcc, 0xc5, 0x76, 0xc9, 0xc8,
+             0xa8, 0xc3, 0x26, 0xbc, 0xf8, 0x82, 0xe3, 0x5c, 0xf9, 0xf6, 0x85, 0x54, 0xe8, 0x9d, 0xf3, 0x2f},
+            {0x7a, 0xc5, 0xef, 0xc3, 0xee, 0x3e, 0xed, 0x77, 0x11, 0x48, 0xff, 0xd4, 0x17, 0x55, 0xe0, 0x04,
+             0xcb, 0x71, 0xa6, 0xf1, 0x3f, 0x7a, 0x3d, 0xea, 0x54, 0xfe, 0x7c, 0x94, 0xb4, 0x33, 0x06, 0x12},
+        },
+        {
+            {0x0a, 0x10, 0x12, 0x49, 0x47, 0x31, 0xbd, 0x82, 0x06, 0xbe, 0x6f, 0x7e, 0x6d, 0x7b, 0x23, 0xde,
+             0xc6, 0x79, 0xea, 0x11, 0x19, 0x76, 0x1e, 0xe1, 0xde, 0x3b, 0x39, 0xcb, 0xe3, 0x3b, 0x43, 0x07},
+            {0x42, 0x00, 0x61, 0x91, 0x78, 0x98, 0x94, 0x0b, 0xe8, 0xfa, 0xeb, 0xec, 0x3c, 0xb1, 0xe7, 0x4e,
+             0xc0, 0xa4, 0xf0, 0x94, 0x95, 0x73, 0xbe, 0x70, 0x85, 0x91, 0xd5, 0xb4, 0x99, 0x0a, 0xd3, 0x35},
+            {0xf4, 0x97, 0xe9, 0x5c, 0xc0, 0x44, 0x79, 0xff, 0xa3, 0x51, 0x5c, 0xb0, 0xe4, 0x3d, 0x5d, 0x57,
+             0x7c, 0x84, 0x76, 0x5a, 0xfd, 0x81, 0x33, 0x58, 0x9f, 0xda, 0xf6, 0x7a, 0xde, 0x3e, 0x87, 0x2d},
+        },
+        {
+            {0x81, 0xf9, 0x5d, 0x4e, 0xe1, 0x02, 0x62, 0xaa, 0xf5, 0xe1, 0x15, 0x50, 0x17, 0x59, 0x0d, 0xa2,
+             0x6c, 0x1d, 0xe2, 0xba, 0xd3, 0x75, 0xa2, 0x18, 0x53, 0x02, 0x60, 0x01, 0x8a, 0x61, 0x43, 0x05},
+            {0x09, 0x34, 0x37, 0x43, 0x64, 0x31, 0x7a, 0x15, 0xd9, 0x81, 0xaa, 0xf4, 0xee, 0xb7, 0xb8, 0xfa,
+             0x06, 0x48, 0xa6, 0xf5, 0xe6, 0xfe, 0x93, 0xb0, 0xb6, 0xa7, 0x7f, 0x70, 0x54, 0x36, 0x77, 0x2e},
+            {0xc1, 0x23, 0x4c, 0x97, 0xf4, 0xbd, 0xea, 0x0d, 0x93, 0x46, 0xce, 0x9d, 0x25, 0x0a, 0x6f, 0xaa,
+             0x2c, 0xba, 0x9a, 0xa2, 0xb8, 0x2c, 0x20, 0x04, 0x0d, 0x96, 0x07, 0x2d, 0x36, 0x43, 0x14, 0x4b},
+        },
+    },
+    {
+        {
+            {0xa4, 0xb0, 0xdd, 0x12, 0x9c, 0x63, 0x98, 0xd5, 0x6b, 0x86, 0x24, 0xc0, 0x30, 0x9f, 0xd1, 0xa5,
+             0x60, 0xe4, 0xfc, 0x58, 0x03, 0x2f, 0x7c, 0xd1, 0x8a, 0x5e, 0x09, 0x2e, 0x15, 0x95, 0xa1, 0x07},
+            {0xde, 0xc4, 0x2e, 0x9c, 0xc5, 0xa9, 0x6f, 0x29, 0xcb, 0xf3, 0x84, 0x4f, 0xbf, 0x61, 0x8b, 0xbc,
+             0x08, 0xf9, 0xa8, 0x17, 0xd9, 0x06, 0x77, 0x1c, 0x5d, 0x25, 0xd3, 0x7a, 0xfc, 0x95, 0xb7, 0x63},
+            {0xc8, 0x5f, 0x9e, 0x38, 0x02, 0x8f, 0x36, 0xa8, 0x3b, 0xe4, 0x8d, 0xcf, 0x02, 0x3b, 0x43, 0x90,
+             0x43, 0x26, 0x41, 0xc5, 0x5d, 0xfd, 0xa1, 0xaf, 0x37, 0x01, 0x2f, 0x03, 0x3d, 0xe8, 0x8f, 0x3e},
+        },
+        {
+            {0x3c, 0xd1, 0xef, 0xe8, 0x8d, 0x4c, 0x70, 0x08, 0x31, 0x37, 0xe0, 0x33, 0x8e, 0x1a, 0xc5, 0xdf,
+             0xe3, 0xcd, 0x60, 0x12, 0xa5, 0x5d, 0x9d, 0xa5, 0x86, 0x8c, 0x25, 0xa6, 0x99, 0x08, 0xd6, 0x22},
+            {0x94, 0xa2, 0x70, 0x05, 0xb9, 0x15, 0x8b, 0x2f, 0x49, 0x45, 0x08, 0x67, 0x70, 0x42, 0xf2, 0x94,
+             0x84, 0xfd, 0xbb, 0x61, 0xe1, 0x5a, 0x1c, 0xde, 0x07, 0x40, 0xac, 0x7f, 0x79, 0x3b, 0xba, 0x75},
+            {0x96, 0xd1, 0xcd, 0x70, 0xc0, 0xdb, 0x39, 0x62, 0x9a, 0x8a, 0x7d, 0x6c, 0x8b, 0x8a, 0xfe, 0x60,
+             0x60, 0x12, 0x40, 0xeb, 0xbc, 0x47, 0x88, 0xb3, 0x5e, 0x9e, 0x77, 0x87, 0x7b, 0xd0, 0x04, 0x09},
+        },
+        {
+            {0xb9, 0x40, 0xf9, 0x48, 0x66, 0x2d, 0x32, 0xf4, 0x39, 0x0c, 0x2d, 0xbd, 0x0c, 0x2f, 0x95, 0x06,
+             0x31, 0xf9, 0x81, 0xa0, 0xad, 0x97, 0x76, 0x16, 0x6c, 0x2a, 0xf7, 0xba, 0xce, 0xaa, 0x40, 0x62},
+            {0x9c, 0x91, 0xba, 0xdd, 0xd4, 0x1f, 0xce, 0xb4, 0xaa, 0x8d, 0x4c, 0xc7, 0x3e, 0xdb, 0x31, 0xcf,
+             0x51, 0xcc, 0x86, 0xad, 0x63, 0xcc, 0x63, 0x2c, 0x07, 0xde, 0x1d, 0xbc, 0x3f, 0x14, 0xe2, 0x43},
+            {0xa0, 0x95, 0xa2, 0x5b, 0x9c, 0x74, 0x34, 0xf8, 0x5a, 0xd2, 0x37, 0xca, 0x5b, 0x7c, 0x94, 0xd6,
+             0x6a, 0x31, 0xc9, 0xe7, 0xa7, 0x3b, 0xf1, 0x66, 0xac, 0x0c, 0xb4, 0x8d, 0x23, 0xaf, 0xbd, 0x56},
+        },
+        {
+            {0xb2, 0x3b, 0x9d, 0xc1, 0x6c, 0xd3, 0x10, 0x13, 0xb9, 0x86, 0x23, 0x62, 0xb7, 0x6b, 0x2a, 0x06,
+             0x5c, 0x4f, 0xa1, 0xd7, 0x91, 0x85, 0x9b, 0x7c, 0x54, 0x57, 0x1e, 0x7e, 0x50, 0x31, 0xaa, 0x03},
+            {0xeb, 0x33, 0x35, 0xf5, 0xe3, 0xb9, 0x2a, 0x36, 0x40, 0x3d, 0xb9, 0x6e, 0xd5, 0x68, 0x85, 0x33,
+             0x72, 0x55, 0x5a, 0x1d, 0x52, 0x14, 0x0e, 0x9e, 0x18, 0x13, 0x74, 0x83, 0x6d, 0xa8, 0x24, 0x1d},
+            {0x1f, 0xce, 0xd4, 0xff, 0x48, 0x76, 0xec, 0xf4, 0x1c, 0x8c, 0xac, 0x54, 0xf0, 0xea, 0x45, 0xe0,
+             0x7c, 0x35, 0x09, 0x1d, 0x82, 0x25, 0xd2, 0x88, 0x59, 0x48, 0xeb, 0x9a, 0xdc, 0x61, 0xb2, 0x43},
+        },
+        {
+            {0x64, 0x13, 0x95, 0x6c, 0x8b, 0x3d, 0x51, 0x19, 0x7b, 0xf4, 0x0b, 0x00, 0x26, 0x71, 0xfe, 0x94,
+             0x67, 0x95, 0x4f, 0xd5, 0xdd, 0x10, 0x8d, 0x02, 0x64, 0x09, 0x94, 0x42, 0xe2, 0xd5, 0xb4, 0x02},
+            {0xbb, 0x79, 0xbb, 0x88, 0x19, 0x1e, 0x5b, 0xe5, 0x9d, 0x35, 0x7a, 0xc1, 0x7d, 0xd0, 0x9e, 0xa0,
+             0x33, 0xea, 0x3d, 0x60, 0xe2, 0x2e, 0x2c, 0xb0, 0xc2, 0x6b, 0x27, 0x5b, 0xcf, 0x55, 0x60, 0x32},
+            {0xf2, 0x8d, 0xd1, 0x28, 0xcb, 0x55, 0xa1, 0xb4, 0x08, 0xe5, 0x6c, 0x18, 0x46, 0x46, 0xcc, 0xea,
+             0x89, 0x43, 0x82, 0x6c, 0x93, 0xf4, 0x9c, 0xc4, 0x10, 0x34, 0x5d, 0xae, 0x09, 0xc8, 0xa6, 0x27},
+        },
+        {
+            {0x54, 0x69, 0x3d, 0xc4, 0x0a, 0x27, 0x2c, 0xcd, 0xb2, 0xca, 0x66, 0x6a, 0x57, 0x3e, 0x4a, 0xdd,
+             0x6c, 0x03, 0xd7, 0x69, 0x24, 0x59, 0xfa, 0x79, 0x99, 0x25, 0x8c, 0x3d, 0x60, 0x03, 0x15, 0x22},
+            {0x88, 0xb1, 0x0d, 0x1f, 0xcd, 0xeb, 0xa6, 0x8b, 0xe8, 0x5b, 0x5a, 0x67, 0x3a, 0xd7, 0xd3, 0x37,
+             0x5a, 0x58, 0xf5, 0x15, 0xa3, 0xdf, 0x2e, 0xf2, 0x7e, 0xa1, 0x60, 0xff, 0x74, 0x71, 0xb6, 0x2c},
+            {0xd0, 0xe1, 0x0b, 0x39, 0xf9, 0xcd, 0xee, 0x59, 0xf1, 0xe3, 0x8c, 0x72, 0x44, 0x20, 0x42, 0xa9,
+             0xf4, 0xf0, 0x94, 0x7a, 0x66, 0x1c, 0x89, 0x82, 0x36, 0xf4, 0x90, 0x38, 0xb7, 0xf4, 0x1d, 0x7b},
+        },
+        {
+            {0x8c, 0xf5, 0xf8, 0x07, 0x18, 0x22, 0x2e, 0x5f, 0xd4, 0x09, 0x94, 0xd4, 0x9f, 0x5c, 0x55, 0xe3,
+             0x30, 0xa6, 0xb6, 0x1f, 0x8d, 0xa8, 0xaa, 0xb2, 0x3d, 0xe0, 0x52, 0xd3, 0x45, 0x82, 0x69, 0x68},
+            {0x24, 0xa2, 0xb2, 0xb3, 0xe0, 0xf2, 0x92, 0xe4, 0x60, 0x11, 0x55, 0x2b, 0x06, 0x9e, 0x6c, 0x7c,
+             0x0e, 0x7b, 0x7f, 0x0d, 0xe2, 0x8f, 0xeb, 0x15, 0x92, 0x59, 0xfc, 0x58, 0x26, 0xef, 0xfc, 0x61},
+            {0x7a, 0x18, 0x18, 0x2a, 0x85, 0x5d, 0xb1, 0xdb, 0xd7, 0xac, 0xdd, 0x86, 0xd3, 0xaa, 0xe4, 0xf3,
+             0x82, 0xc4, 0xf6, 0x0f, 0x81, 0xe2, 0xba, 0x44, 0xcf, 0x01, 0xaf, 0x3d, 0x47, 0x4c, 0xcf, 0x46},
+        },
+        {
+            {0x40, 0x81, 0x49, 0xf1, 0xa7, 0x6e, 0x3c, 0x21, 0x54, 0x48, 0x2b, 0x39, 0xf8, 0x7e, 0x1e, 0x7c,
+             0xba, 0xce, 0x29, 0x56, 0x8c, 0xc3, 0x88, 0x24, 0xbb, 0xc5, 0x8c, 0x0d, 0xe5, 0xaa, 0x65, 0x10},
+            {0xf9, 0xe5, 0xc4, 0x9e, 0xed, 0x25, 0x65, 0x42, 0x03, 0x33, 0x90, 0x16, 0x01, 0xda, 0x5e, 0x0e,
+             0xdc, 0xca, 0xe5, 0xcb, 0xf2, 0xa7, 0xb1, 0x72, 0x40, 0x5f, 0xeb, 0x14, 0xcd, 0x7b, 0x38, 0x29},
+            {0x57, 0x0d, 0x20, 0xdf, 0x25, 0x45, 0x2c, 0x1c, 0x4a, 0x67, 0xca, 0xbf, 0xd6, 0x2d, 0x3b, 0x5c,
+             0x30, 0x40, 0x83, 0xe1, 0xb1, 0xe7, 0x07, 0x0a, 0x16, 0xe7, 0x1c, 0x4f, 0xe6, 0x98, 0xa1, 0x69},
+        },
+    },
+    {
+        {
+            {0xa2, 0x8e, 0xad, 0xac, 0xbf, 0x04, 0x3b, 0x58, 0x84, 0xe8, 0x8b, 0x14, 0xe8, 0x43, 0xb7, 0x29,
+             0xdb, 0xc5, 0x10, 0x08, 0x3b, 0x58, 0x1e, 0x2b, 0xaa, 0xbb, 0xb3, 0x8e, 0xe5, 0x49, 0x54, 0x2b},
+            {0x47, 0xbe, 0x3d, 0xeb, 0x62, 0x75, 0x3a, 0x5f, 0xb8, 0xa0, 0xbd, 0x8e, 0x54, 0x38, 0xea, 0xf7,
+             0x99, 0x72, 0x74, 0x45, 0x31, 0xe5, 0xc3, 0x00, 0x51, 0xd5, 0x27, 0x16, 0xe7, 0xe9, 0x04, 0x13},
+            {0xfe, 0x9c, 0xdc, 0x6a, 0xd2, 0x14, 0x98, 0x78, 0x0b, 0xdd, 0x48, 0x8b, 0x3f, 0xab, 0x1b, 0x3c,
+             0x0a, 0xc6, 0x79, 0xf9, 0xff, 0xe1, 0x0f, 0xda, 0x93, 0xd6, 0x2d, 0x7c, 0x2d, 0xde, 0x68, 0x44},
+        },
+        {
+            {0xce, 0x07, 0x63, 0xf8, 0xc6, 0xd8, 0x9a, 0x4b, 0x28, 0x0c, 0x5d, 0x43, 0x31, 0x35, 0x11, 0x21,
+             0x2c, 0x77, 0x7a, 0x65, 0xc5, 0x66, 0xa8, 0xd4, 0x52, 0x73, 0x24, 0x63, 0x7e, 0x42, 0xa6, 0x5d},
+            {0x9e, 0x46, 0x19, 0x94, 0x5e, 0x35, 0xbb, 0x51, 0x54, 0xc7, 0xdd, 0x23, 0x4c, 0xdc, 0xe6, 0x33,
+             0x62, 0x99, 0x7f, 0x44, 0xd6, 0xb6, 0xa5, 0x93, 0x63, 0xbd, 0x44, 0xfb, 0x6f, 0x7c, 0xce, 0x6c},
+            {0xca, 0x22, 0xac, 0xde, 0x88, 0xc6, 0x94, 0x1a, 0xf8, 0x1f, 0xae, 0xbb, 0xf7, 0x6e, 0x06, 0xb9,
+             0x0f, 0x58, 0x59, 0x8d, 0x38, 0x8c, 0xad, 0x88, 0xa8, 0x2c, 0x9f, 0xe7, 0xbf, 0x9a, 0xf2, 0x58},
+        },
+        {
+            {0xf6, 0xcd, 0x0e, 0x71, 0xbf, 0x64, 0x5a, 0x4b, 0x3c, 0x29, 0x2c, 0x46, 0x38, 0xe5, 0x4c, 0xb1,
+             0xb9, 0x3a, 0x0b, 0xd5, 0x56, 0xd0, 0x43, 0x36, 0x70, 0x48, 0x5b, 0x18, 0x24, 0x37, 0xf9, 0x6a},
+            {0x68, 0x3e, 0xe7, 0x8d, 0xab, 0xcf, 0x0e, 0xe9, 0xa5, 0x76, 0x7e, 0x37, 0x9f, 0x6f, 0x03, 0x54,
+             0x82, 0x59, 0x01, 0xbe, 0x0b, 0x5b, 0x49, 0xf0, 0x36, 0x1e, 0xf4, 0xa7, 0xc4, 0x29, 0x76, 0x57},
+            {0x88, 0xa8, 0xc6, 0x09, 0x45, 0x02, 0x20, 0x32, 0x73, 0x89, 0x55, 0x4b, 0x13, 0x36, 0xe0, 0xd2,
+             0x9f, 0x28, 0x33, 0x3c, 0x23, 0x36, 0xe2, 0x83, 0x8f, 0xc1, 0xae, 0x0c, 0xbb, 0x25, 0x1f, 0x70},
+        },
+        {
+            {0x13, 0xc1, 0xbe, 0x7c, 0xd9, 0xf6, 0x18, 0x9d, 0xe4, 0xdb, 0xbf, 0x74, 0xe6, 0x06, 0x4a, 0x84,
+             0xd6, 0x60, 0x4e, 0xac, 0x22, 0xb5, 0xf5, 0x20, 0x51, 0x5e, 0x95, 0x50, 0xc0, 0x5b, 0x0a, 0x72},
+            {0xed, 0x6c, 0x61, 0xe4, 0xf8, 0xb0, 0xa8, 0xc3, 0x7d, 0xa8, 0x25, 0x9e, 0x0e, 0x66, 0x00, 0xf7,
+             0x9c, 0xa5, 0xbc, 0xf4, 0x1f, 0x06, 0xe3, 0x61, 0xe9, 0x0b, 0xc4, 0xbd, 0xbf, 0x92, 0x0c, 0x2e},
+            {0x35, 0x5a, 0x80, 0x9b, 0x43, 0x09, 0x3f, 0x0c, 0xfc, 0xab, 0x42, 0x62, 0x37, 0x8b, 0x4e, 0xe8,
+             0x46, 0x93, 0x22, 0x5c, 0xf3, 0x17, 0x14, 0x69, 0xec, 0xf0, 0x4e, 0x14, 0xbb, 0x9c, 0x9b, 0x0e},
+        },
+        {
+            {0xee, 0xbe, 0xb1, 0x5d, 0xd5, 0x9b, 0xee, 0x8d, 0xb9, 0x3f, 0x72, 0x0a, 0x37, 0xab, 0xc3, 0xc9,
+             0x91, 0xd7, 0x68, 0x1c, 0xbf, 0xf1, 0xa8, 0x44, 0xde, 0x3c, 0xfd, 0x1c, 0x19, 0x44, 0x6d, 0x36},
+            {0xad, 0x20, 0x57, 0xfb, 0x8f, 0xd4, 0xba, 0xfb, 0x0e, 0x0d, 0xf9, 0xdb, 0x6b, 0x91, 0x81, 0xee,
+             0xbf, 0x43, 0x55, 0x63, 0x52, 0x31, 0x81, 0xd4, 0xd8, 0x7b, 0x33, 0x3f, 0xeb, 0x04, 0x11, 0x22},
+            {0x14, 0x8c, 0xbc, 0xf2, 0x43, 0x17, 0x3c, 0x9e, 0x3b, 0x6c, 0x85, 0xb5, 0xfc, 0x26, 0xda, 0x2e,
+             0x97, 0xfb, 0xa7, 0x68, 0x0e, 0x2f, 0xb8, 0xcc, 0x44, 0x32, 0x59, 0xbc, 0xe6, 0xa4, 0x67, 0x41},
+        },
+        {
+            {0xee, 0x8f, 0xce, 0xf8, 0x65, 0x26, 0xbe, 0xc2, 0x2c, 0xd6, 0x80, 0xe8, 0x14, 0xff, 0x67, 0xe9,
+             0xee, 0x4e, 0x36, 0x2f, 0x7e, 0x6e, 0x2e, 0xf1, 0xf6, 0xd2, 0x7e, 0xcb, 0x70, 0x33, 0xb3, 0x34},
+            {0x00, 0x27, 0xf6, 0x76, 0x28, 0x9d, 0x3b, 0x64, 0xeb, 0x68, 0x76, 0x0e, 0x40, 0x9d, 0x1d, 0x5d,
+             0x84, 0x06, 0xfc, 0x21, 0x03, 0x43, 0x4b, 0x1b, 0x6a, 0x24, 0x55, 0x22, 0x7e, 0xbb, 0x38, 0x79},
+            {0xcc, 0xd6, 0x81, 0x86, 0xee, 0x91, 0xc5, 0xcd, 0x53, 0xa7, 0x85, 0xed, 0x9c, 0x10, 0x02, 0xce,
+             0x83, 0x88, 0x80, 0x58, 0xc1, 0x85, 0x74, 0xed, 0xe4, 0x65, 0xfe, 0x2d, 0x6e, 0xfc, 0x76, 0x11},
+        },
+        {
+            {0xb8, 0x0e, 0x77, 0x49, 0x89, 0xe2, 0x90, 0xdb, 0xa3, 0x40, 0xf4, 0xac, 0x2a, 0xcc, 0xfb, 0x98,
+             0x9b, 0x87, 0xd7, 0xde, 0xfe, 0x4f, 0x35, 0x21, 0xb6, 0x06, 0x69, 0xf2, 0x54, 0x3e, 0x6a, 0x1f},
+            {0x9b, 0x61, 0x9c, 0x5b, 0xd0, 0x6c, 0xaf, 0xb4, 0x80, 0x84, 0xa5, 0xb2, 0xf4, 0xc9, 0xdf, 0x2d,
+             0xc4, 0x4d, 0xe9, 0xeb, 0x02, 0xa5, 0x4f, 0x3d, 0x34, 0x5f, 0x7d, 0x67, 0x4c, 0x3a, 0xfc, 0x08},
+            {0xea, 0x34, 0x07, 0xd3, 0x99, 0xc1, 0xa4, 0x60, 0xd6, 0x5c, 0x16, 0x31, 0xb6, 0x85, 0xc0, 0x40,
+             0x95, 0x82, 0x59, 0xf7, 0x23, 0x3e, 0x33, 0xe2, 0xd1, 0x00, 0xb9, 0x16, 0x01, 0xad, 0x2f, 0x4f},
+        },
+        {
+            {0x38, 0xb6, 0x3b, 0xb7, 0x1d, 0xd9, 0x2c, 0x96, 0x08, 0x9c, 0x12, 0xfc, 0xaa, 0x77, 0x05, 0xe6,
+             0x89, 0x16, 0xb6, 0xf3, 0x39, 0x9b, 0x61, 0x6f, 0x81, 0xee, 0x44, 0x29, 0x5f, 0x99, 0x51, 0x34},
+            {0x54, 0x4e, 0xae, 0x94, 0x41, 0xb2, 0xbe, 0x44, 0x6c, 0xef, 0x57, 0x18, 0x51, 0x1c, 0x54, 0x5f,
+             0x98, 0x04, 0x8d, 0x36, 0x2d, 0x6b, 0x1e, 0xa6, 0xab, 0xf7, 0x2e, 0x97, 0xa4, 0x84, 0x54, 0x44},
+            {0x7c, 0x7d, 0xea, 0x9f, 0xd0, 0xfc, 0x52, 0x91, 0xf6, 0x5c, 0x93, 0xb0, 0x94, 0x6c, 0x81, 0x4a,
+             0x40, 0x5c, 0x28, 0x47, 0xaa, 0x9a, 0x8e, 0x25, 0xb7, 0x93, 0x28, 0x04, 0xa6, 0x9c, 0xb8, 0x10},
+        },
+    },
+    {
+        {
+            {0x51, 0x2f, 0x5b, 0x30, 0xfb, 0xbf, 0xee, 0x96, 0xb8, 0x96, 0x95, 0x88, 0xad, 0x38, 0xf9, 0xd3,
+             0x25, 0xdd, 0xd5, 0x46, 0xc7, 0x2d, 0xf5, 0xf0, 0x95, 0x00, 0x3a, 0xbb, 0x90, 0x82, 0x96, 0x57},
+            {0xdc, 0xae, 0x58, 0x8c, 0x4e, 0x97, 0x37, 0x46, 0xa4, 0x41, 0xf0, 0xab, 0xfb, 0x22, 0xef, 0xb9,
+             0x8a, 0x71, 0x80, 0xe9, 0x56, 0xd9, 0x85, 0xe1, 0xa6, 0xa8, 0x43, 0xb1, 0xfa, 0x78, 0x1b, 0x2f},
+            {0x01, 0xe1, 0x20, 0x0a, 0x43, 0xb8, 0x1a, 0xf7, 0x47, 0xec, 0xf0, 0x24, 0x8d, 0x65, 0x93, 0xf3,
+             0xd1, 0xee, 0xe2, 0x6e, 0xa8, 0x09, 0x75, 0xcf, 0xe1, 0xa3, 0x2a, 0xdc, 0x35, 0x3e, 0xc4, 0x7d},
+        },
+        {
+            {0x18, 0x97, 0x3e, 0x27, 0x5c, 0x2a, 0x78, 0x5a, 0x94, 0xfd, 0x4e, 0x5e, 0x99, 0xc6, 0x76, 0x35,
+             0x3e, 0x7d, 0x23, 0x1f, 0x05, 0xd8, 0x2e, 0x0f, 0x99, 0x0a, 0xd5, 0x82, 0x1d, 0xb8, 0x4f, 0x04},
+            {0xc3, 0xd9, 0x7d, 0x88, 0x65, 0x66, 0x96, 0x85, 0x55, 0x53, 0xb0, 0x4b, 0x31, 0x9b, 0x0f, 0xc9,
+             0xb1, 0x79, 0x20, 0xef, 0xf8, 0x8d, 0xe0, 0xc6, 0x2f, 0xc1, 0x8c, 0x75, 0x16, 0x20, 0xf7, 0x7e},
+            {0xd9, 0xe3, 0x07, 0xa9, 0xc5, 0x18, 0xdf, 0xc1, 0x59, 0x63, 0x4c, 0xce, 0x1d, 0x37, 0xb3, 0x57,
+             0x49, 0xbb, 0x01, 0xb2, 0x34, 0x45, 0x70, 0xca, 0x2e, 0xdd, 0x30, 0x9c, 0x3f, 0x82, 0x79, 0x7f},
+        },
+        {
+            {0xba, 0x87, 0xf5, 0x68, 0xf0, 0x1f, 0x9c, 0x6a, 0xde, 0xc8, 0x50, 0x00, 0x4e, 0x89, 0x27, 0x08,
+             0xe7, 0x5b, 0xed, 0x7d, 0x55, 0x99, 0xbf, 0x3c, 0xf0, 0xd6, 0x06, 0x1c, 0x43, 0xb0, 0xa9, 0x64},
+            {0xe8, 0x13, 0xb5, 0xa3, 0x39, 0xd2, 0x34, 0x83, 0xd8, 0xa8, 0x1f, 0xb9, 0xd4, 0x70, 0x36, 0xc1,
+             0x33, 0xbd, 0x90, 0xf5, 0x36, 0x41, 0xb5, 0x12, 0xb4, 0xd9, 0x84, 0xd7, 0x73, 0x03, 0x4e, 0x0a},
+            {0x19, 0x29, 0x7d, 0x5b, 0xa1, 0xd6, 0xb3, 0x2e, 0x35, 0x82, 0x3a, 0xd5, 0xa0, 0xf6, 0xb4, 0xb0,
+             0x47, 0x5d, 0xa4, 0x89, 0x43, 0xce, 0x56, 0x71, 0x6c, 0x34, 0x18, 0xce, 0x0a, 0x7d, 0x1a, 0x07},
+        },
+        {
+            {0x31, 0x44, 0xe1, 0x20, 0x52, 0x35, 0x0c, 0xcc, 0x41, 0x51, 0xb1, 0x09, 0x07, 0x95, 0x65, 0x0d,
+             0x36, 0x5f, 0x9d, 0x20, 0x1b, 0x62, 0xf5, 0x9a, 0xd3, 0x55, 0x77, 0x61, 0xf7, 0xbc, 0x69, 0x7c},
+            {0x0b, 0xba, 0x87, 0xc8, 0xaa, 0x2d, 0x07, 0xd3, 0xee, 0x62, 0xa5, 0xbf, 0x05, 0x29, 0x26, 0x01,
+             0x8b, 0x76, 0xef, 0xc0, 0x02, 0x30, 0x54, 0xcf, 0x9c, 0x7e, 0xea, 0x46, 0x71, 0xcc, 0x3b, 0x2c},
+            {0x5f, 0x29, 0xe8, 0x04, 0xeb, 0xd7, 0xf0, 0x07, 0x7d, 0xf3, 0x50, 0x2f, 0x25, 0x18, 0xdb, 0x10,
+             0xd7, 0x98, 0x17, 0x17, 0xa3, 0xa9, 0x51, 0xe9, 0x1d, 0xa5, 0xac, 0x22, 0x73, 0x9a, 0x5a, 0x6f},
+        },
+        {
+            {0xbe, 0x44, 0xd9, 0xa3, 0xeb, 0xd4, 0x29, 0xe7, 0x9e, 0xaf, 0x78, 0x80, 0x40, 0x09, 0x9e, 0x8d,
+             0x03, 0x9c, 0x86, 0x47, 0x7a, 0x56, 0x25, 0x45, 0x24, 0x3b, 0x8d, 0xee, 0x80, 0x96, 0xab, 0x02},
+            {0xc5, 0xc6, 0x41, 0x2f, 0x0c, 0x00, 0xa1, 0x8b, 0x9b, 0xfb, 0xfe, 0x0c, 0xc1, 0x79, 0x9f, 0xc4,
+             0x9f, 0x1c, 0xc5, 0x3c, 0x70, 0x47, 0xfa, 0x4e, 0xca, 0xaf, 0x47, 0xe1, 0xa2, 0x21, 0x4e, 0x49},
+            {0x9a, 0x0d, 0xe5, 0xdd, 0x85, 0x8a, 0xa4, 0xef, 0x49, 0xa2, 0xb9, 0x0f, 0x4e, 0x22, 0x9a, 0x21,
+             0xd9, 0xf6, 0x1e, 0xd9, 0x1d, 0x1f, 0x09, 0xfa, 0x34, 0xbb, 0x46, 0xea, 0xcb, 0x76, 0x5d, 0x6b},
+        },
+        {
+            {0x22, 0x25, 0x78, 0x1e, 0x17, 0x41, 0xf9, 0xe0, 0xd3, 0x36, 0x69, 0x03, 0x74, 0xae, 0xe6, 0xf1,
+             0x46, 0xc7, 0xfc, 0xd0, 0xa2, 0x3e, 0x8b, 0x40, 0x3e, 0x31, 0xdd, 0x03, 0x9c, 0x86, 0xfb, 0x16},
+            {0x94, 0xd9, 0x0c, 0xec, 0x6c, 0x55, 0x57, 0x88, 0xba, 0x1d, 0xd0, 0x5c, 0x6f, 0xdc, 0x72, 0x64,
+             0x77, 0xb4, 0x42, 0x8f, 0x14, 0x69, 0x01, 0xaf, 0x54, 0x73, 0x27, 0x85, 0xf6, 0x33, 0xe3, 0x0a},
+            {0x62, 0x09, 0xb6, 0x33, 0x97, 0x19, 0x8e, 0x28, 0x33, 0xe1, 0xab, 0xd8, 0xb4, 0x72, 0xfc, 0x24,
+             0x3e, 0xd0, 0x91, 0x09, 0xed, 0xf7, 0x11, 0x48, 0x75, 0xd0, 0x70, 0x8f, 0x8b, 0xe3, 0x81, 0x3f},
+        },
+        {
+            {0x24, 0xc8, 0x17, 0x5f, 0x35, 0x7f, 0xdb, 0x0a, 0xa4, 0x99, 0x42, 0xd7, 0xc3, 0x23, 0xb9, 0x74,
+             0xf7, 0xea, 0xf8, 0xcb, 0x8b, 0x3e, 0x7c, 0xd5, 0x3d, 0xdc, 0xde, 0x4c, 0xd3, 0xe2, 0xd3, 0x0a},
+            {0xfe, 0xaf, 0xd9, 0x7e, 0xcc, 0x0f, 0x91, 0x7f, 0x4b, 0x87, 0x65, 0x24, 0xa1, 0xb8, 0x5c, 0x54,
+             0x04, 0x47, 0x0c, 0x4b, 0xd2, 0x7e, 0x39, 0xa8, 0x93, 0x09, 0xf5, 0x04, 0xc1, 0x0f, 0x51, 0x50},
+            {0x9d, 0x24, 0x6e, 0x33, 0xc5, 0x0f, 0x0c, 0x6f, 0xd9, 0xcf, 0x31, 0xc3, 0x19, 0xde, 0x5e, 0x74,
+             0x1c, 0xfe, 0xee, 0x09, 0x00, 0xfd, 0xd6, 0xf2, 0xbe, 0x1e, 0xfa, 0xf0, 0x8b, 0x15, 0x7c, 0x12},
+        },
+        {
+            {0x74, 0xb9, 0x51, 0xae, 0xc4, 0x8f, 0xa2, 0xde, 0x96, 0xfe, 0x4d, 0x74, 0xd3, 0x73, 0x99, 0x1d,
+             0xa8, 0x48, 0x38, 0x87, 0x0b, 0x68, 0x40, 0x62, 0x95, 0xdf, 0x67, 0xd1, 0x79, 0x24, 0xd8, 0x4e},
+            {0xa2, 0x79, 0x98, 0x2e, 0x42, 0x7c, 0x19, 0xf6, 0x47, 0x36, 0xca, 0x52, 0xd4, 0xdd, 0x4a, 0xa4,
+             0xcb, 0xac, 0x4e, 0x4b, 0xc1, 0x3f, 0x41, 0x9b, 0x68, 0x4f, 0xef, 0x07, 0x7d, 0xf8, 0x4e, 0x35},
+            {0x75, 0xd9, 0xc5, 0x60, 0x22, 0xb5, 0xe3, 0xfe, 0xb8, 0xb0, 0x41, 0xeb, 0xfc, 0x2e, 0x35, 0x50,
+             0x3c, 0x65, 0xf6, 0xa9, 0x30, 0xac, 0x08, 0x88, 0x6d, 0x23, 0x39, 0x05, 0xd2, 0x92, 0x2d, 0x30},
+        },
+    },
+    {
+        {
+            {0xc0, 0x1a, 0x0c, 0xc8, 0x9d, 0xcc, 0x6d, 0xa6, 0x36, 0xa4, 0x38, 0x1b, 0xf4, 0x5c, 0xa0, 0x97,
+             0xc6, 0xd7, 0xdb, 0x95, 0xbe, 0xf3, 0xeb, 0xa7, 0xab, 0x7d, 0x7e, 0x8d, 0xf6, 0xb8, 0xa0, 0x7d},
+            {0xa6, 0x75, 0x56, 0x38, 0x14, 0x20, 0x78, 0xef, 0xe8, 0xa9, 0xfd, 0xaa, 0x30, 0x9f, 0x64, 0xa2,
+             0xcb, 0xa8, 0xdf, 0x5c, 0x50, 0xeb, 0xd1, 0x4c, 0xb3, 0xc0, 0x4d, 0x1d, 0xba, 0x5a, 0x11, 0x46},
+            {0x76, 0xda, 0xb5, 0xc3, 0x53, 0x19, 0x0f, 0xd4, 0x9b, 0x9e, 0x11, 0x21, 0x73, 0x6f, 0xac, 0x1d,
+             0x60, 0x59, 0xb2, 0xfe, 0x21, 0x60, 0xcc, 0x03, 0x4b, 0x4b, 0x67, 0x83, 0x7e, 0x88, 0x5f, 0x5a},
+        },
+        {
+            {0xb9, 0x43, 0xa6, 0xa0, 0xd3, 0x28, 0x96, 0x9e, 0x64, 0x20, 0xc3, 0xe6, 0x00, 0xcb, 0xc3, 0xb5,
+             0x32, 0xec, 0x2d, 0x7c, 0x89, 0x02, 0x53, 0x9b, 0x0c, 0xc7, 0xd1, 0xd5, 0xe2, 0x7a, 0xe3, 0x43},
+            {0x11, 0x3d, 0xa1, 0x70, 0xcf, 0x01, 0x63, 0x8f, 0xc4, 0xd0, 0x0d, 0x35, 0x15, 0xb8, 0xce, 0xcf,
+             0x7e, 0xa4, 0xbc, 0xa4, 0xd4, 0x97, 0x02, 0xf7, 0x34, 0x14, 0x4d, 0xe4, 0x56, 0xb6, 0x69, 0x36},
+            {0x33, 0xe1, 0xa6, 0xed, 0x06, 0x3f, 0x7e, 0x38, 0xc0, 0x3a, 0xa1, 0x99, 0x51, 0x1d, 0x30, 0x67,
+             0x11, 0x38, 0x26, 0x36, 0xf8, 0xd8, 0x5a, 0xbd, 0xbe, 0xe9, 0xd5, 0x4f, 0xcd, 0xe6, 0x21, 0x6a},
+        },
+        {
+            {0xe3, 0xb2, 0x99, 0x66, 0x12, 0x29, 0x41, 0xef, 0x01, 0x13, 0x8d, 0x70, 0x47, 0x08, 0xd3, 0x71,
+             0xbd, 0xb0, 0x82, 0x11, 0xd0, 0x32, 0x54, 0x32, 0x36, 0x8b, 0x1e, 0x00, 0x07, 0x1b, 0x37, 0x45},
+            {0x5f, 0xe6, 0x46, 0x30, 0x0a, 0x17, 0xc6, 0xf1, 0x24, 0x35, 0xd2, 0x00, 0x2a, 0x2a, 0x71, 0x58,
+             0x55, 0xb7, 0x82, 0x8c, 0x3c, 0xbd, 0xdb, 0x69, 0x57, 0xff, 0x95, 0xa1, 0xf1, 0xf9, 0x6b, 0x58},
+            {0x0b, 0x79, 0xf8, 0x5e, 0x8d, 0x08, 0xdb, 0xa6, 0xe5, 0x37, 0x09, 0x61, 0xdc, 0xf0, 0x78, 0x52,
+             0xb8, 0x6e, 0xa1, 0x61, 0xd2, 0x49, 0x03, 0xac, 0x79, 0x21, 0xe5, 0x90, 0x37, 0xb0, 0xaf, 0x0e},
+        },
+        {
+            {0x1d, 0xae, 0x75, 0x0f, 0x5e, 0x80, 0x40, 0x51, 0x30, 0xcc, 0x62, 0x26, 0xe3, 0xfb, 0x02, 0xec,
+             0x6d, 0x39, 0x92, 0xea, 0x1e, 0xdf, 0xeb, 0x2c, 0xb3, 0x5b, 0x43, 0xc5, 0x44, 0x33, 0xae, 0x44},
+            {0x2f, 0x04, 0x48, 0x37, 0xc1, 0x55, 0x05, 0x96, 0x11, 0xaa, 0x0b, 0x82, 0xe6, 0x41, 0x9a, 0x21,
+             0x0c, 0x6d, 0x48, 0x73, 0x38, 0xf7, 0x81, 0x1c, 0x61, 0xc6, 0x02, 0x5a, 0x67, 0xcc, 0x9a, 0x30},
+            {0xee, 0x43, 0xa5, 0xbb, 0xb9, 0x89, 0xf2, 0x9c, 0x42, 0x71, 0xc9, 0x5a, 0x9d, 0x0e, 0x76, 0xf3,
+             0xaa, 0x60, 0x93, 0x4f, 0xc6, 0xe5, 0x82, 0x1d, 0x8f, 0x67, 0x94, 0x7f, 0x1b, 0x22, 0xd5, 0x62},
+        },
+        {
+            {0x3c, 0x7a, 0xf7, 0x3a, 0x26, 0xd4, 0x85, 0x75, 0x4d, 0x14, 0xe9, 0xfe, 0x11, 0x7b, 0xae, 0xdf,
+             0x3d, 0x19, 0xf7, 0x59, 0x80, 0x70, 0x06, 0xa5, 0x37, 0x20, 0x92, 0x83, 0x53, 0x9a, 0xf2, 0x14},
+            {0x6d, 0x93, 0xd0, 0x18, 0x9c, 0x29, 0x4c, 0x52, 0x0c, 0x1a, 0x0c, 0x8a, 0x6c, 0xb5, 0x6b, 0xc8,
+             0x31, 0x86, 0x4a, 0xdb, 0x2e, 0x05, 0x75, 0xa3, 0x62, 0x45, 0x75, 0xbc, 0xe4, 0xfd, 0x0e, 0x5c},
+            {0xf5, 0xd7, 0xb2, 0x25, 0xdc, 0x7e, 0x71, 0xdf, 0x40, 0x30, 0xb5, 0x99, 0xdb, 0x70, 0xf9, 0x21,
+             0x62, 0x4c, 0xed, 0xc3, 0xb7, 0x34, 0x92, 0xda, 0x3e, 0x09, 0xee, 0x7b, 0x5c, 0x36, 0x72, 0x5e},
+        },
+        {
+            {0x3e, 0xb3, 0x08, 0x2f, 0x06, 0x39, 0x93, 0x7d, 0xbe, 0x32, 0x9f, 0xdf, 0xe5, 0x59, 0x96, 0x5b,
+             0xfd, 0xbd, 0x9e, 0x1f, 0xad, 0x3d, 0xff, 0xac, 0xb7, 0x49, 0x73, 0xcb, 0x55, 0x05, 0xb2, 0x70},
+            {0x7f, 0x21, 0x71, 0x45, 0x07, 0xfc, 0x5b, 0x57, 0x5b, 0xd9, 0x94, 0x06, 0x5d, 0x67, 0x79, 0x37,
+             0x33, 0x1e, 0x19, 0xf4, 0xbb, 0x37, 0x0a, 0x9a, 0xbc, 0xea, 0xb4, 0x47, 0x4c, 0x10, 0xf1, 0x77},
+            {0x4c, 0x2c, 0x11, 0x55, 0xc5, 0x13, 0x51, 0xbe, 0xcd, 0x1f, 0x88, 0x9a, 0x3a, 0x42, 0x88, 0x66,
+             0x47, 0x3b, 0x50, 0x5e, 0x85, 0x77, 0x66, 0x44, 0x4a, 0x40, 0x06, 0x4a, 0x8f, 0x39, 0x34, 0x0e},
+        },
+        {
+            {0x28, 0x19, 0x4b, 0x3e, 0x09, 0x0b, 0x93, 0x18, 0x40, 0xf6, 0xf3, 0x73, 0x0e, 0xe1, 0xe3, 0x7d,
+             0x6f, 0x5d, 0x39, 0x73, 0xda, 0x17, 0x32, 0xf4, 0x3e, 0x9c, 0x37, 0xca, 0xd6, 0xde, 0x8a, 0x6f},
+            {0xe8, 0xbd, 0xce, 0x3e, 0xd9, 0x22, 0x7d, 0xb6, 0x07, 0x2f, 0x82, 0x27, 0x41, 0xe8, 0xb3, 0x09,
+             0x8d, 0x6d, 0x5b, 0xb0, 0x1f, 0xa6, 0x3f, 0x74, 0x72, 0x23, 0x36, 0x8a, 0x36, 0x05, 0x54, 0x5e},
+            {0x9a, 0xb2, 0xb7, 0xfd, 0x3d, 0x12, 0x40, 0xe3, 0x91, 0xb2, 0x1a, 0xa2, 0xe1, 0x97, 0x7b, 0x48,
+             0x9e, 0x94, 0xe6, 0xfd, 0x02, 0x7d, 0x96, 0xf9, 0x97, 0xde, 0xd3, 0xc8, 0x2e, 0xe7, 0x0d, 0x78},
+        },
+        {
+            {0x72, 0x27, 0xf4, 0x00, 0xf3, 0xea, 0x1f, 0x67, 0xaa, 0x41, 0x8c, 0x2a, 0x2a, 0xeb, 0x72, 0x8f,
+             0x92, 0x32, 0x37, 0x97, 0xd7, 0x7f, 0xa1, 0x29, 0xa6, 0x87, 0xb5, 0x32, 0xad, 0xc6, 0xef, 0x1d},
+            {0xbc, 0xe7, 0x9a, 0x08, 0x45, 0x85, 0xe2, 0x0a, 0x06, 0x4d, 0x7f, 0x1c, 0xcf, 0xde, 0x8d, 0x38,
+             0xb8, 0x11, 0x48, 0x0a, 0x51, 0x15, 0xac, 0x38, 0xe4, 0x8c, 0x92, 0x71, 0xf6, 0x8b, 0xb2, 0x0e},
+            {0xa7, 0x95, 0x51, 0xef, 0x1a, 0xbe, 0x5b, 0xaf, 0xed, 0x15, 0x7b, 0x91, 0x77, 0x12, 0x8c, 0x14,
+             0x2e, 0xda, 0xe5, 0x7a, 0xfb, 0xf7, 0x91, 0x29, 0x67, 0x28, 0xdd, 0xf8, 0x1b, 0x20, 0x7d, 0x46},
+        },
+    },
+    {
+        {
+            {0x7f, 0x87, 0x3b, 0x19, 0xc9, 0x00, 0x2e, 0xbb, 0x6b, 0x50, 0xdc, 0xe0, 0x90, 0xa8, 0xe3, 0xec,
+             0x9f, 0x64, 0xde, 0x36, 0xc0, 0xb7, 0xf3, 0xec, 0x1a, 0x9e, 0xde, 0x98, 0x08, 0x04, 0x46, 0x5f},
+            {0xdb, 0xce, 0x2f, 0x83, 0x45, 0x88, 0x9d, 0x73, 0x63, 0xf8, 0x6b, 0xae, 0xc9, 0xd6, 0x38, 0xfa,
+             0xf7, 0xfe, 0x4f, 0xb7, 0xca, 0x0d, 0xbc, 0x32, 0x5e, 0xe4, 0xbc, 0x14, 0x88, 0x7e, 0x93, 0x73},
+            {0x8d, 0xf4, 0x7b, 0x29, 0x16, 0x71, 0x03, 0xb9, 0x34, 0x68, 0xf0, 0xd4, 0x22, 0x3b, 0xd1, 0xa9,
+             0xc6, 0xbd, 0x96, 0x46, 0x57, 0x15, 0x97, 0xe1, 0x35, 0xe8, 0xd5, 0x91, 0xe8, 0xa4, 0xf8, 0x2c},
+        },
+        {
+            {0xa2, 0x6b, 0xd0, 0x17, 0x7e, 0x48, 0xb5, 0x2c, 0x6b, 0x19, 0x50, 0x39, 0x1c, 0x38, 0xd2, 0x24,
+             0x30, 0x8a, 0x97, 0x85, 0x81, 0x9c, 0x65, 0xd7, 0xf6, 0xa4, 0xd6, 0x91, 0x28, 0x7f, 0x6f, 0x7a},
+            {0x67, 0x0f, 0x11, 0x07, 0x87, 0xfd, 0x93, 0x6d, 0x49, 0xb5, 0x38, 0x7c, 0xd3, 0x09, 0x4c, 0xdd,
+             0x86, 0x6a, 0x73, 0xc2, 0x4c, 0x6a, 0xb1, 0x7c, 0x09, 0x2a, 0x25, 0x58, 0x6e, 0xbd, 0x49, 0x20},
+            {0x49, 0xef, 0x9a, 0x6a, 0x8d, 0xfd, 0x09, 0x7d, 0x0b, 0xb9, 0x3d, 0x5b, 0xbe, 0x60, 0xee, 0xf0,
+             0xd4, 0xbf, 0x9e, 0x51, 0x2c, 0xb5, 0x21, 0x4c, 0x1d, 0x94, 0x45, 0xc5, 0xdf, 0xaa, 0x11, 0x60},
+        },
+        {
+            {0x90, 0xf8, 0xcb, 0x02, 0xc8, 0xd0, 0xde, 0x63, 0xaa, 0x6a, 0xff, 0x0d, 0xca, 0x98, 0xd0, 0xfb,
+             0x99, 0xed, 0xb6, 0xb9, 0xfd, 0x0a, 0x4d, 0x62, 0x1e, 0x0b, 0x34, 0x79, 0xb7, 0x18, 0xce, 0x69},
+            {0x3c, 0xf8, 0x95, 0xcf, 0x6d, 0x92, 0x67, 0x5f, 0x71, 0x90, 0x28, 0x71, 0x61, 0x85, 0x7e, 0x7c,
+             0x5b, 0x7a, 0x8f, 0x99, 0xf3, 0xe7, 0xa1, 0xd6, 0xe0, 0xf9, 0x62, 0x0b, 0x1b, 0xcc, 0xc5, 0x6f},
+            {0xcb, 0x79, 0x98, 0xb2, 0x28, 0x55, 0xef, 0xd1, 0x92, 0x90, 0x7e, 0xd4, 0x3c, 0xae, 0x1a, 0xdd,
+             0x52, 0x23, 0x9f, 0x18, 0x42, 0x04, 0x7e, 0x12, 0xf1, 0x01, 0x71, 0xe5, 0x3a, 0x6b, 0x59, 0x15},
+        },
+        {
+            {0xca, 0x24, 0x51, 0x7e, 0x16, 0x31, 0xff, 0x09, 0xdf, 0x45, 0xc7, 0xd9, 0x8b, 0x15, 0xe4, 0x0b,
+             0xe5, 0x56, 0xf5, 0x7e, 0x22, 0x7d, 0x2b, 0x29, 0x38, 0xd1, 0xb6, 0xaf, 0x41, 0xe2, 0xa4, 0x3a},
+            {0xa2, 0x79, 0x91, 0x3f, 0xd2, 0x39, 0x27, 0x46, 0xcf, 0xdd, 0xd6, 0x97, 0x31, 0x12, 0x83, 0xff,
+             0x8a, 0x14, 0xf2, 0x53, 0xb5, 0xde, 0x07, 0x13, 0xda, 0x4d, 0x5f, 0x7b, 0x68, 0x37, 0x22, 0x0d},
+            {0xf5, 0x05, 0x33, 0x2a, 0xbf, 0x38, 0xc1, 0x2c, 0xc3, 0x26, 0xe9, 0xa2, 0x8f, 0x3f, 0x58, 0x48,
+             0xeb, 0xd2, 0x49, 0x55, 0xa2, 0xb1, 0x3a, 0x08, 0x6c, 0xa3, 0x87, 0x46, 0x6e, 0xaa, 0xfc, 0x32},
+        },
+        {
+            {0xdf, 0xcc, 0x87, 0x27, 0x73, 0xa4, 0x07, 0x32, 0xf8, 0xe3, 0x13, 0xf2, 0x08, 0x19, 0xe3, 0x17,
+             0x4e, 0x96, 0x0d, 0xf6, 0xd7, 0xec, 0xb2, 0xd5, 0xe9, 0x0b, 0x60, 0xc2, 0x36, 0x63, 0x6f, 0x74},
+            {0xf5, 0x9a, 0x7d, 0xc5, 0x8d, 0x6e, 0xc5, 0x7b, 0xf2, 0xbd, 0xf0, 0x9d, 0xed, 0xd2, 0x0b, 0x3e,
+             0xa3, 0xe4, 0xef, 0x22, 0xde, 0x14, 0xc0, 0xaa, 0x5c, 0x6a, 0xbd, 0xfe, 0xce, 0xe9, 0x27, 0x46},
+            {0x1c, 0x97, 0x6c, 0xab, 0x45, 0xf3, 0x4a, 0x3f, 0x1f, 0x73, 0x43, 0x99, 0x72, 0xeb, 0x88, 0xe2,
+             0x6d, 0x18, 0x44, 0x03, 0x8a, 0x6a, 0x59, 0x33, 0x93, 0x62, 0xd6, 0x7e, 0x00, 0x17, 0x49, 0x7b},
+        },
+        {
+            {0xdd, 0xa2, 0x53, 0xdd, 0x28, 0x1b, 0x34, 0x54, 0x3f, 0xfc, 0x42, 0xdf, 0x5b, 0x90, 0x17, 0xaa,
+             0xf4, 0xf8, 0xd2, 0x4d, 0xd9, 0x92, 0xf5, 0x0f, 0x7d, 0xd3, 0x8c, 0xe0, 0x0f, 0x62, 0x03, 0x1d},
+            {0x64, 0xb0, 0x84, 0xab, 0x5c, 0xfb, 0x85, 0x2d, 0x14, 0xbc, 0xf3, 0x89, 0xd2, 0x10, 0x78, 0x49,
+             0x0c, 0xce, 0x15, 0x7b, 0x44, 0xdc, 0x6a, 0x47, 0x7b, 0xfd, 0x44, 0xf8, 0x76, 0xa3, 0x2b, 0x12},
+            {0x54, 0xe5, 0xb4, 0xa2, 0xcd, 0x32, 0x02, 0xc2, 0x7f, 0x18, 0x5d, 0x11, 0x42, 0xfd, 0xd0, 0x9e,
+             0xd9, 0x79, 0xd4, 0x7d, 0xbe, 0xb4, 0xab, 0x2e, 0x4c, 0xec, 0x68, 0x2b, 0xf5, 0x0b, 0xc7, 0x02},
+        },
+        {
+            {0xe1, 0x72, 0x8d, 0x45, 0xbf, 0x32, 0xe5, 0xac, 0xb5, 0x3c, 0xb7, 0x7c, 0xe0, 0x68, 0xe7, 0x5b,
+             0xe7, 0xbd, 0x8b, 0xee, 0x94, 0x7d, 0xcf, 0x56, 0x03, 0x3a, 0xb4, 0xfe, 0xe3, 0x97, 0x06, 0x6b},
+            {0xbb, 0x2f, 0x0b, 0x5d, 0x4b, 0xec, 0x87, 0xa2, 0xca, 0x82, 0x48, 0x07, 0x90, 0x57, 0x5c, 0x41,
+             0x5c, 0x81, 0xd0, 0xc1, 0x1e, 0xa6, 0x44, 0xe0, 0xe0, 0xf5, 0x9e, 0x40, 0x0a, 0x4f, 0x33, 0x26},
+            {0xc0, 0xa3, 0x62, 0xdf, 0x4a, 0xf0, 0xc8, 0xb6, 0x5d, 0xa4, 0x6d, 0x07, 0xef, 0x00, 0xf0, 0x3e,
+             0xa9, 0xd2, 0xf0, 0x49, 0x58, 0xb9, 0x9c, 0x9c, 0xae, 0x2f, 0x1b, 0x44, 0x43, 0x7f, 0xc3, 0x1c},
+        },
+        {
+            {0xb9, 0xae, 0xce, 0xc9, 0xf1, 0x56, 0x66, 0xd7, 0x6a, 0x65, 0xe5, 0x18, 0xf8, 0x15, 0x5b, 0x1c,
+             0x34, 0x23, 0x4c, 0x84, 0x32, 0x28, 0xe7, 0x26, 0x38, 0x68, 0x19, 0x2f, 0x77, 0x6f, 0x34, 0x3a},
+            {0x4f, 0x32, 0xc7, 0x5c, 0x5a, 0x56, 0x8f, 0x50, 0x22, 0xa9, 0x06, 0xe5, 0xc0, 0xc4, 0x61, 0xd0,
+             0x19, 0xac, 0x45, 0x5c, 0xdb, 0xab, 0x18, 0xfb, 0x4a, 0x31, 0x80, 0x03, 0xc1, 0x09, 0x68, 0x6c},
+            {0xc8, 0x6a, 0xda, 0xe2, 0x12, 0x51, 0xd5, 0xd2, 0xed, 0x51, 0xe8, 0xb1, 0x31, 0x03, 0xbd, 0xe9,
+             0x62, 0x72, 0xc6, 0x8e, 0xdd, 0x46, 0x07, 0x96, 0xd0, 0xc5, 0xf7, 0x6e, 0x9f, 0x1b, 0x91, 0x05},
+        },
+    },
+};
+
+static void fe25519_set(fe25519_t *h, int32_t v)
+{
+    memset(h, 0, sizeof(*h));
+    h->v[0] = v;
+}
+
+static void fe25519_neg(fe25519_t *h, const fe25519_t *f)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        h->v[i] = -f->v[i];
     }
+}
 
-    mp_point_t *p1 = MP_OBJ_TO_PTR(point1);
-    mp_point_t *p2 = MP_OBJ_TO_PTR(point2);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
+static bool fe25519_is_negative(const fe25519_t *f)
+{
+    byte s[32];
+    fe25519_to_bytes(s, f);
+    return s[0] & 1;
+}
 
-    // -point2.y % curve.p
-    fp_int *p2_y_fp_int = fp_alloc();
+static bool fe25519_equal(const fe25519_t *f, const fe25519_t *g)
+{
+    byte fs[32], gs[32];
+    fe25519_to_bytes(fs, f);
+    fe25519_to_bytes(gs, g);
+    return memcmp(fs, gs, 32) == 0;
+}
 
-    fp_copy(p2->ecc_point->y, p2_y_fp_int);
+static void ed25519_point_identity(ed25519_point_t *p)
+{
+    fe25519_set(&p->x, 0);
+    fe25519_set(&p->y, 1);
+    fe25519_set(&p->z, 1);
+    fe25519_set(&p->t, 0);
+}
 
-    fp_neg(p2->ecc_point->y, p2->ecc_point->y);
-    fp_mod(p2->ecc_point->y, c->ecc_curve->p, p2->ecc_point->y);
+static void ed25519_point_to_cached(ed25519_cached_t *c, const ed25519_point_t *p)
+{
+    fe25519_t d2;
+    fe25519_from_bytes(&d2, ed25519_d2);
+    fe25519_add(&c->yplusx, &p->y, &p->x);
+    fe25519_carry(&c->yplusx);
+    fe25519_sub(&c->yminusx, &p->y, &p->x);
+    fe25519_carry(&c->yminusx);
+    c->z = p->z;
+    fe25519_mul(&c->t2d, &p->t, &d2);
+}
 
-    mp_point_t *pr = new_point_init_copy(c);
-    ec_point_add(pr->ecc_point, p1->ecc_point, p2->ecc_point, c->ecc_curve);
+// c = -c, swapping Y + X with Y - X, if b, without branches
+static void ed25519_cached_cneg(ed25519_cached_t *c, int32_t b)
+{
+    fe25519_t t2d;
+    fe25519_neg(&t2d, &c->t2d);
+    fe25519_cswap(&c->yplusx, &c->yminusx, b);
+    fe25519_cswap(&c->t2d, &t2d, b);
+}
 
-    // restore point.y
-    fp_copy(p2_y_fp_int, p2->ecc_point->y);
+// r = p + q, complete (add-2008-hwcd-3 with a = -1), r may be p
+static void ed25519_add(ed25519_point_t *r, const ed25519_point_t *p, const ed25519_cached_t *q)
+{
+    fe25519_t a, b, c, d, e, f, g, h;
+
+    // A = (Y1 - X1) * (Y2 - X2), B = (Y1 + X1) * (Y2 + X2), C = T1 * 2d * T2, D = 2 * Z1 * Z2
+    fe25519_sub(&e, &p->y, &p->x);
+    fe25519_mul(&a, &e, &q->yminusx);
+    fe25519_add(&e, &p->y, &p->x);
+    fe25519_mul(&b, &e, &q->yplusx);
+    fe25519_mul(&c, &p->t, &q->t2d);
+    fe25519_mul(&d, &p->z, &q->z);
+    fe25519_mul_small(&d, &d, 2);
+
+    // E = B - A, F = D - C, G = D + C, H = B + A
+    fe25519_sub(&e, &b, &a);
+    fe25519_sub(&f, &d, &c);
+    fe25519_add(&g, &d, &c);
+    fe25519_add(&h, &b, &a);
+
+    fe25519_mul(&r->x, &e, &f);
+    fe25519_mul(&r->y, &g, &h);
+    fe25519_mul(&r->t, &e, &h);
+    fe25519_mul(&r->z, &f, &g);
+}
 
-    fp_free(p2_y_fp_int);
+// r = 2 * p (dbl-2008-hwcd with a = -1), r may be p
+static void ed25519_double(ed25519_point_t *r, const ed25519_point_t *p)
+{
+    fe25519_t a, b, c, e, f, g, h;
+
+    // A = X1^2, B = Y1^2, C = 2 * Z1^2
+    fe25519_sqr(&a, &p->x);
+    fe25519_sqr(&b, &p->y);
+    fe25519_sqr(&c, &p->z);
+    fe25519_mul_small(&c, &c, 2);
+
+    // E = (X1 + Y1)^2 - A - B, G = B - A, F = G - C, H = -A - B
+    fe25519_add(&e, &p->x, &p->y);
+    fe25519_sqr(&e, &e);
+    fe25519_add(&h, &a, &b);
+    fe25519_sub(&e, &e, &h);
+    fe25519_carry(&e);
+    fe25519_neg(&h, &h);
+    fe25519_sub(&g, &b, &a);
+    fe25519_sub(&f, &g, &c);
+    fe25519_carry(&f);
+
+    fe25519_mul(&r->x, &e, &f);
+    fe25519_mul(&r->y, &g, &h);
+    fe25519_mul(&r->t, &e, &h);
+    fe25519_mul(&r->z, &f, &g);
+}
 
-    return MP_OBJ_FROM_PTR(pr);
+// s = compressed p: y with the sign of x in the top bit
+static void ed25519_point_to_bytes(byte *s, const ed25519_point_t *p)
+{
+    fe25519_t zinv, x, y;
+
+    fe25519_invert(&zinv, &p->z);
+    fe25519_mul(&x, &p->x, &zinv);
+    fe25519_mul(&y, &p->y, &zinv);
+    fe25519_to_bytes(s, &y);
+    s[31] ^= (byte)(fe25519_is_negative(&x) << 7);
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_3(point_sub_obj, point_sub);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_sub_obj, MP_ROM_PTR(&point_sub_obj));
+// p = decompressed s (RFC 8032 5.1.3), returns false if s is not a point
+static bool ed25519_point_from_bytes(ed25519_point_t *p, const byte *s)
+{
+    fe25519_t u, v, v3, vxx, check, d;
+    byte canonical[32];
+
+    // y must be reduced
+    fe25519_from_bytes(&p->y, s);
+    fe25519_to_bytes(canonical, &p->y);
+    canonical[31] |= s[31] & 0x80;
+    if (memcmp(canonical, s, 32) != 0)
+    {
+        return false;
+    }
+
+    // x = (u / v)^((p + 3) / 8) = u * v^3 * (u * v^7)^((p - 5) / 8), u = y^2 - 1, v = d * y^2 + 1
+    fe25519_from_bytes(&d, ed25519_d);
+    fe25519_set(&p->z, 1);
+    fe25519_sqr(&u, &p->y);
+    fe25519_mul(&v, &u, &d);
+    fe25519_sub(&u, &u, &p->z);
+    fe25519_carry(&u);
+    fe25519_add(&v, &v, &p->z);
+    fe25519_carry(&v);
+
+    fe25519_sqr(&v3, &v);
+    fe25519_mul(&v3, &v3, &v);
+    fe25519_sqr(&p->x, &v3);
+    fe25519_mul(&p->x, &p->x, &v);
+    fe25519_mul(&p->x, &p->x, &u);
+    fe25519_pow22523(&p->x, &p->x);
+    fe25519_mul(&p->x, &p->x, &v3);
+    fe25519_mul(&p->x, &p->x, &u);
+
+    // v * x^2 is u, or -u and x needs a factor sqrt(-1), or u / v is not a square
+    fe25519_sqr(&vxx, &p->x);
+    fe25519_mul(&vxx, &vxx, &v);
+    if (!fe25519_equal(&vxx, &u))
+    {
+        fe25519_neg(&check, &u);
+        if (!fe25519_equal(&vxx, &check))
+        {
+            return false;
+        }
+        fe25519_from_bytes(&check, ed25519_sqrtm1);
+        fe25519_mul(&p->x, &p->x, &check);
+    }
 
-static mp_obj_t point_mul(mp_obj_t point, mp_obj_t scalar, mp_obj_t curve)
-{
-    if (!MP_OBJ_IS_TYPE(point, &point_type))
+    fe25519_to_bytes(canonical, &p->x);
+    bool zero = true;
+    for (int i = 0; i < 32; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(point));
+        zero = zero && canonical[i] == 0;
     }
-    if (!MP_OBJ_IS_INT(scalar))
+    if (zero && (s[31] >> 7))
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 2, mp_obj_get_type_str(scalar));
+        return false;
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    if ((canonical[0] & 1) != (s[31] >> 7))
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 3, mp_obj_get_type_str(curve));
+        fe25519_neg(&p->x, &p->x);
     }
 
-    mp_point_t *p = MP_OBJ_TO_PTR(point);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
-
-    fp_int *s_fp_int = fp_alloc();
-
-    mp_fp_for_int(scalar, s_fp_int);
-
-    mp_point_t *pr = new_point_init_copy(c);
-    ec_point_mul(pr->ecc_point, p->ecc_point, *s_fp_int, c->ecc_curve);
+    fe25519_mul(&p->t, &p->x, &p->y);
+    return true;
+}
 
-    fp_free(s_fp_int);
+// c = digit * 16^(8 * window) * B from the comb, digit in [-8, 8], reading every entry of the window
+static void ed25519_base_comb_select(ed25519_cached_t *c, int window, int digit)
+{
+    byte entry[3][32];
+    int32_t negative = (int32_t)((uint32_t)digit >> 31);
+    uint32_t index = (uint32_t)((digit ^ -(int)negative) + (int)negative);
+
+    // the identity (1, 1, 0)
+    memset(entry, 0, sizeof(entry));
+    entry[0][0] = 1;
+    entry[1][0] = 1;
+    for (uint32_t j = 1; j <= 8; j++)
+    {
+        byte mask = (byte)(0 - ((((j ^ index) - 1) >> 31) & 1));
+        const byte *src = &ed25519_base_comb[window][j - 1][0][0];
+        for (size_t l = 0; l < sizeof(entry); l++)
+        {
+            ((byte *)entry)[l] ^= mask & (((byte *)entry)[l] ^ src[l]);
+        }
+    }
 
-    return MP_OBJ_FROM_PTR(pr);
+    fe25519_from_bytes(&c->yplusx, entry[0]);
+    fe25519_from_bytes(&c->yminusx, entry[1]);
+    fe25519_from_bytes(&c->t2d, entry[2]);
+    fe25519_set(&c->z, 1);
+    ed25519_cached_cneg(c, negative);
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_3(point_mul_obj, point_mul);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_mul_obj, MP_ROM_PTR(&point_mul_obj));
-
-static mp_obj_t signature(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+// r = a * B for a little endian a < 2^255, in constant time: a in signed radix 16 digits e[0..63] and
+// r = sum over k of 16^k * sum over i of e[8 * i + k] * 16^(8 * i) * B
+static void ed25519_scalarmult_base(ed25519_point_t *r, const byte *a)
 {
-    static const mp_arg_t allowed_args[] = {
-        {MP_QSTR_r, MP_ARG_OBJ, {.u_obj = mp_const_none}},
-        {MP_QSTR_s, MP_ARG_OBJ, {.u_obj = mp_const_none}}};
+    int8_t e[64];
+    int carry = 0;
+    ed25519_cached_t c;
 
-    struct
+    for (int i = 0; i < 32; i++)
     {
-        mp_arg_val_t r, s;
-    } args;
-    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+        e[2 * i] = a[i] & 15;
+        e[2 * i + 1] = (a[i] >> 4) & 15;
+    }
+    for (int i = 0; i < 63; i++)
+    {
+        e[i] += carry;
+        carry = (e[i] + 8) >> 4;
+        e[i] -= carry << 4;
+    }
+    e[63] += carry;
 
-    mp_ecdsa_signature_t *signature = m_new_obj(mp_ecdsa_signature_t);
-    signature->base.type = &signature_type;
-    for (size_t i = 0; i < n_args; i++)
+    ed25519_point_identity(r);
+    for (int k = 7; k >= 0; k--)
     {
-        if (!MP_OBJ_IS_INT(pos_args[i]))
+        if (k < 7)
         {
-            mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, mp_obj_get_type_str(pos_args[i]), i);
+            for (int i = 0; i < 4; i++)
+            {
+                ed25519_double(r, r);
+            }
+        }
+        for (int i = 0; i < 8; i++)
+        {
+            ed25519_base_comb_select(&c, i, e[8 * i + k]);
+            ed25519_add(r, r, &c);
         }
     }
 
-    signature->ecdsa_signature = m_new_obj(ecdsa_signature_t);
-    signature->ecdsa_signature->r = fp_alloc();
-    signature->ecdsa_signature->s = fp_alloc();
+    memset(e, 0, sizeof(e));
+}
 
-    mp_fp_for_int(args.r.u_obj, signature->ecdsa_signature->r);
-    mp_fp_for_int(args.s.u_obj, signature->ecdsa_signature->s);
+// a = the little endian len bytes of b
+static void fp_read_le(fp_int *a, const byte *b, size_t len)
+{
+    byte be[64];
+    for (size_t i = 0; i < len; i++)
+    {
+        be[i] = b[len - 1 - i];
+    }
+    fp_read_unsigned_bin(a, be, (int)len);
+    memset(be, 0, sizeof(be));
+}
 
-    return MP_OBJ_FROM_PTR(signature);
+// b = a as 32 little endian bytes, a < 2^256
+static void fp_write_le32(byte *b, fp_int *a)
+{
+    byte be[32];
+    int size = fp_unsigned_bin_size(a);
+
+    memset(be, 0, sizeof(be));
+    fp_to_unsigned_bin(a, &be[32 - size]);
+    for (int i = 0; i < 32; i++)
+    {
+        b[i] = be[31 - i];
+    }
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_KW(signature_obj, 2, signature);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_signature_obj, MP_ROM_PTR(&signature_obj));
+// k = sha512(r || a || m) mod L, little endian
+static void ed25519_challenge(fp_int *k, const byte *r, const byte *a, const byte *m, size_t len, fp_int *order)
+{
+    sha512_ctx_t ctx;
+    byte digest[64];
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, r, 32);
+    sha512_update(&ctx, a, 32);
+    sha512_update(&ctx, m, len);
+    sha512_final(&ctx, digest);
+    fp_read_le(k, digest, sizeof(digest));
+    fp_mod(k, order, k);
+}
 
-static mp_obj_t ecdsa_sign(size_t n_args, const mp_obj_t *args)
+// az = sha512(secret) with the scalar half clamped, pk = az[0..31] * B compressed
+static void ed25519_expand(byte *az, byte *pk, const byte *secret)
 {
-    (void)n_args;
-    mp_obj_t msg = args[0];
-    mp_obj_t d = args[1];
-    mp_obj_t k = args[2];
-    mp_obj_t curve = args[3];
+    sha512_ctx_t ctx;
+    ed25519_point_t A;
+
+    sha512_init(&ctx);
+    sha512_update(&ctx, secret, 32);
+    sha512_final(&ctx, az);
+    az[0] &= 248;
+    az[31] &= 127;
+    az[31] |= 64;
+
+    ed25519_scalarmult_base(&A, az);
+    ed25519_point_to_bytes(pk, &A);
+}
 
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(msg, &bufinfo, MP_BUFFER_READ);
-    if (!MP_OBJ_IS_INT(d))
+// sig = R || S of RFC 8032 5.1.6
+static void ed25519_sign_(byte *sig, const byte *m, size_t len, const byte *secret)
+{
+    sha512_ctx_t ctx;
+    byte az[64], pk[32], nonce[64];
+    ed25519_point_t R;
+    fp_int *order = fp_alloc_scratch();
+    fp_int *r = fp_alloc_scratch();
+    fp_int *k = fp_alloc_scratch();
+    fp_int *a = fp_alloc_scratch();
+
+    fp_read_unsigned_bin(order, ed25519_order, sizeof(ed25519_order));
+    ed25519_expand(az, pk, secret);
+
+    // r = sha512(prefix || m) mod L, R = r * B
+    sha512_init(&ctx);
+    sha512_update(&ctx, &az[32], 32);
+    sha512_update(&ctx, m, len);
+    sha512_final(&ctx, nonce);
+    fp_read_le(r, nonce, sizeof(nonce));
+    fp_mod(r, order, r);
+    fp_write_le32(nonce, r);
+    ed25519_scalarmult_base(&R, nonce);
+    ed25519_point_to_bytes(sig, &R);
+
+    // S = r + k * a mod L
+    ed25519_challenge(k, sig, pk, m, len, order);
+    fp_read_le(a, az, 32);
+    fp_mulmod(k, a, order, k);
+    fp_add(k, r, k);
+    fp_mod(k, order, k);
+    fp_write_le32(&sig[32], k);
+
+    memset(az, 0, sizeof(az));
+    memset(nonce, 0, sizeof(nonce));
+    fp_zero(r);
+    fp_zero(a);
+    fp_free(order);
+    fp_free(r);
+    fp_free(k);
+    fp_free(a);
+}
+
+// cofactorless check of RFC 8032 5.1.7: R == S * B - k * A, in variable time
+static bool ed25519_verify_(const byte *sig, const byte *m, size_t len, const byte *pk)
+{
+    ed25519_point_t A, R;
+    ed25519_cached_t *odd_a = m_new(ed25519_cached_t, 8);
+    ed25519_cached_t odd_b[4], c;
+    int8_t naf_s[254], naf_k[254];
+    byte check[32];
+    fp_int *order = fp_alloc_scratch();
+    fp_int *s = fp_alloc_scratch();
+    fp_int *k = fp_alloc_scratch();
+    bool ok = false;
+
+    fp_read_unsigned_bin(order, ed25519_order, sizeof(ed25519_order));
+    fp_read_le(s, &sig[32], 32);
+    if (fp_cmp(s, order) != FP_LT || !ed25519_point_from_bytes(&A, pk))
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 2, mp_obj_get_type_str(d));
+        goto cleanup;
     }
-    if (!MP_OBJ_IS_INT(k))
+    ed25519_challenge(k, sig, pk, m, len, order);
+
+    // odd multiples of -A, width 5, and of B out of the first window of the comb, width 4
+    fe25519_neg(&A.x, &A.x);
+    fe25519_neg(&A.t, &A.t);
+    ed25519_point_to_cached(&odd_a[0], &A);
+    ed25519_double(&R, &A);
+    ed25519_point_to_cached(&c, &R);
+    for (int i = 1; i < 8; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_INT_AT_BUT, 3, mp_obj_get_type_str(k));
+        ed25519_add(&A, &A, &c);
+        ed25519_point_to_cached(&odd_a[i], &A);
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    for (int i = 0; i < 4; i++)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 4, mp_obj_get_type_str(curve));
+        ed25519_base_comb_select(&odd_b[i], 0, 2 * i + 1);
     }
 
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
-
-    fp_int *d_fp_int = fp_alloc();
-    fp_int *k_fp_int = fp_alloc();
+    int len_s = ec_scalar_wnaf(naf_s, s, 4);
+    int len_k = ec_scalar_wnaf(naf_k, k, 5);
+    int bits = (len_s > len_k) ? len_s : len_k;
 
-    mp_fp_for_int(d, d_fp_int);
-    mp_fp_for_int(k, k_fp_int);
+    ed25519_point_identity(&R);
+    for (int bit = bits - 1; bit >= 0; bit--)
+    {
+        ed25519_double(&R, &R);
+        if (bit < len_s && naf_s[bit] != 0)
+        {
+            c = odd_b[(naf_s[bit] < 0 ? -naf_s[bit] : naf_s[bit]) >> 1];
+            ed25519_cached_cneg(&c, naf_s[bit] < 0);
+            ed25519_add(&R, &R, &c);
+        }
+        if (bit < len_k && naf_k[bit] != 0)
+        {
+            c = odd_a[(naf_k[bit] < 0 ? -naf_k[bit] : naf_k[bit]) >> 1];
+            ed25519_cached_cneg(&c, naf_k[bit] < 0);
+            ed25519_add(&R, &R, &c);
+        }
+    }
 
-    mp_ecdsa_signature_t *sr = m_new_obj(mp_ecdsa_signature_t);
-    sr->base.type = &signature_type;
+    ed25519_point_to_bytes(check, &R);
+    ok = memcmp(check, sig, 32) == 0;
 
-    sr->ecdsa_signature = m_new_obj(ecdsa_signature_t);
-    sr->ecdsa_signature->r = fp_alloc();
-    sr->ecdsa_signature->s = fp_alloc();
+cleanup:
+    m_del(ed25519_cached_t, odd_a, 8);
+    fp_free(order);
+    fp_free(s);
+    fp_free(k);
+    return ok;
+}
 
-    ecdsa_s(sr->ecdsa_signature, bufinfo.buf, bufinfo.len, *d_fp_int, *k_fp_int, c->ecc_curve);
+static mp_obj_t ed25519_public_key(mp_obj_t secret)
+{
+    fp_scratch_enter();
 
-    fp_free(d_fp_int);
-    fp_free(k_fp_int);
+    mp_buffer_info_t bufinfo_secret;
+    mp_get_buffer_raise(secret, &bufinfo_secret, MP_BUFFER_READ);
+    if (bufinfo_secret.len != 32)
+    {
+        mp_raise_ValueError(ERROR_ED25519_SECRET_LEN);
+    }
 
-    return MP_OBJ_FROM_PTR(sr);
+    byte az[64], pk[32];
+    ed25519_expand(az, pk, (const byte *)bufinfo_secret.buf);
+    memset(az, 0, sizeof(az));
+    return mp_obj_new_bytes(pk, sizeof(pk));
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ecdsa_sign_obj, 4, 4, ecdsa_sign);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdsa_sign_obj, MP_ROM_PTR(&ecdsa_sign_obj));
+static MP_DEFINE_CONST_FUN_OBJ_1(ed25519_public_key_obj, ed25519_public_key);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ed25519_public_key_obj, MP_ROM_PTR(&ed25519_public_key_obj));
 
-static mp_obj_t ecdsa_verify(size_t n_args, const mp_obj_t *args)
+static mp_obj_t ed25519_sign(mp_obj_t msg, mp_obj_t secret)
 {
-    (void)n_args;
-    mp_obj_t signature = args[0];
-    mp_obj_t msg = args[1];
-    mp_obj_t Q = args[2];
-    mp_obj_t curve = args[3];
+    fp_scratch_enter();
 
-    if (!MP_OBJ_IS_TYPE(signature, &signature_type))
-    {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_SIGNATURE_AT_BUT, 1, mp_obj_get_type_str(signature));
-    }
-    mp_buffer_info_t bufinfo;
-    mp_get_buffer_raise(msg, &bufinfo, MP_BUFFER_READ);
-    if (!MP_OBJ_IS_TYPE(Q, &point_type))
+    mp_buffer_info_t bufinfo_msg;
+    mp_buffer_info_t bufinfo_secret;
+    mp_get_buffer_raise(msg, &bufinfo_msg, MP_BUFFER_READ);
+    mp_get_buffer_raise(secret, &bufinfo_secret, MP_BUFFER_READ);
+    if (bufinfo_secret.len != 32)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 3, mp_obj_get_type_str(Q));
+        mp_raise_ValueError(ERROR_ED25519_SECRET_LEN);
     }
-    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+
+    byte sig[64];
+    ed25519_sign_(sig, (const byte *)bufinfo_msg.buf, bufinfo_msg.len, (const byte *)bufinfo_secret.buf);
+    return mp_obj_new_bytes(sig, sizeof(sig));
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(ed25519_sign_obj, ed25519_sign);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ed25519_sign_obj, MP_ROM_PTR(&ed25519_sign_obj));
+
+static mp_obj_t ed25519_verify(mp_obj_t signature, mp_obj_t msg, mp_obj_t public_key)
+{
+    fp_scratch_enter();
+
+    mp_buffer_info_t bufinfo_signature;
+    mp_buffer_info_t bufinfo_msg;
+    mp_buffer_info_t bufinfo_public_key;
+    mp_get_buffer_raise(signature, &bufinfo_signature, MP_BUFFER_READ);
+    mp_get_buffer_raise(msg, &bufinfo_msg, MP_BUFFER_READ);
+    mp_get_buffer_raise(public_key, &bufinfo_public_key, MP_BUFFER_READ);
+
+    if (bufinfo_signature.len != 64 || bufinfo_public_key.len != 32)
     {
-        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 4, mp_obj_get_type_str(curve));
+        return mp_const_false;
     }
-
-    mp_ecdsa_signature_t *s = MP_OBJ_TO_PTR(signature);
-    mp_point_t *q = MP_OBJ_TO_PTR(Q);
-    mp_curve_t *c = MP_OBJ_TO_PTR(curve);
-    return mp_obj_new_bool(ecdsa_v(s->ecdsa_signature, bufinfo.buf, bufinfo.len, q->ecc_point, c->ecc_curve));
+    return mp_obj_new_bool(ed25519_verify_((const byte *)bufinfo_signature.buf, (const byte *)bufinfo_msg.buf, bufinfo_msg.len, (const byte *)bufinfo_public_key.buf));
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(ecdsa_verify_obj, 4, 4, ecdsa_verify);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ecdsa_verify_obj, MP_ROM_PTR(&ecdsa_verify_obj));
+static MP_DEFINE_CONST_FUN_OBJ_3(ed25519_verify_obj, ed25519_verify);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_ed25519_verify_obj, MP_ROM_PTR(&ed25519_verify_obj));
 
 static void point_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
 {
@@ -1899,6 +6900,8 @@ static void point_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind
 
 static void point_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
 {
+    fp_scratch_enter();
+
     mp_point_t *self = MP_OBJ_TO_PTR(obj);
     if (dest[0] == MP_OBJ_NULL)
     {
@@ -1919,7 +6922,7 @@ static void point_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
             }
             else if (attr == MP_QSTR_curve)
             {
-                dest[0] = new_curve_init_copy(self);
+                dest[0] = new_curve_init_shared(self->ecc_curve);
                 return;
             }
             mp_convert_member_lookup(obj, type, elem->value, dest);
@@ -1948,26 +6951,7 @@ static void point_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
         {
             mp_curve_t *other = MP_OBJ_TO_PTR(dest[1]);
 
-            self->ecc_curve = m_new_obj(ecc_curve_t);
-            self->ecc_curve->p = fp_alloc();
-            self->ecc_curve->a = fp_alloc();
-            self->ecc_curve->b = fp_alloc();
-            self->ecc_curve->q = fp_alloc();
-            self->ecc_curve->g = m_new_obj(ecc_point_t);
-            self->ecc_curve->g->x = fp_alloc();
-            self->ecc_curve->g->y = fp_alloc();
-
-            vstr_init(&self->ecc_curve->name, vstr_len(&other->ecc_curve->oid));
-            vstr_add_strn(&self->ecc_curve->name, vstr_str(&other->ecc_curve->name), vstr_len(&other->ecc_curve->name));
-            vstr_init(&self->ecc_curve->oid, vstr_len(&other->ecc_curve->oid));
-            vstr_add_strn(&self->ecc_curve->oid, vstr_str(&other->ecc_curve->oid), vstr_len(&other->ecc_curve->oid));
-
-            fp_copy(other->ecc_curve->p, self->ecc_curve->p);
-            fp_copy(other->ecc_curve->a, self->ecc_curve->a);
-            fp_copy(other->ecc_curve->b, self->ecc_curve->b);
-            fp_copy(other->ecc_curve->q, self->ecc_curve->q);
-            fp_copy(other->ecc_curve->g->x, self->ecc_curve->g->x);
-            fp_copy(other->ecc_curve->g->y, self->ecc_curve->g->y);
+            self->ecc_curve = other->ecc_curve;
         }
         else
         {
@@ -1979,6 +6963,8 @@ static void point_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
 
 static mp_obj_t point_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
 {
+    fp_scratch_enter();
+
     switch (op)
     {
     case MP_BINARY_OP_ADD:
@@ -1994,8 +6980,8 @@ static mp_obj_t point_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
             mp_raise_ValueError(ERROR_CURVE_OF_POINTS_NOT_EQUAL);
         }
 
-        mp_curve_t *c = new_curve_init_copy(l);
-        return point_add(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(c));
+        mp_curve_t c = {{&curve_type}, l->ecc_curve};
+        return point_add(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(&c));
     }
     case MP_BINARY_OP_SUBTRACT:
     {
@@ -2010,8 +6996,8 @@ static mp_obj_t point_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
             mp_raise_ValueError(ERROR_CURVE_OF_POINTS_NOT_EQUAL);
         }
 
-        mp_curve_t *c = new_curve_init_copy(l);
-        return point_sub(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(c));
+        mp_curve_t c = {{&curve_type}, l->ecc_curve};
+        return point_sub(MP_OBJ_FROM_PTR(l), MP_OBJ_FROM_PTR(r), MP_OBJ_FROM_PTR(&c));
     }
     case MP_BINARY_OP_MULTIPLY:
 #if defined(MICROPY_PY_ALL_SPECIAL_METHODS) && defined(MICROPY_PY_REVERSE_SPECIAL_METHODS)
@@ -2027,8 +7013,8 @@ static mp_obj_t point_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
             mp_raise_TypeError(ERROR_RIGHT_EXPECTED_INT);
         }
         mp_point_t *l = MP_OBJ_TO_PTR(lhs);
-        mp_curve_t *c = new_curve_init_copy(l);
-        return point_mul(MP_OBJ_FROM_PTR(l), rhs, MP_OBJ_FROM_PTR(c));
+        mp_curve_t c = {{&curve_type}, l->ecc_curve};
+        return point_mul_helper(MP_OBJ_FROM_PTR(l), rhs, MP_OBJ_FROM_PTR(&c), false);
     }
     case MP_BINARY_OP_EQUAL:
     {
@@ -2051,24 +7037,19 @@ static mp_obj_t point_binary_op(mp_binary_op_t op, mp_obj_t lhs, mp_obj_t rhs)
 
 static mp_obj_t point_unary_op(mp_unary_op_t op, mp_obj_t self_in)
 {
+    fp_scratch_enter();
+
     mp_point_t *point = MP_OBJ_TO_PTR(self_in);
     switch (op)
     {
     case MP_UNARY_OP_NEGATIVE:
     {
-        // copy point.y
-        fp_int *point_y_fp_int = fp_alloc();
-
-        fp_copy(point->ecc_point->y, point_y_fp_int);
+        mp_point_t *pr = new_point_init_shared(point->ecc_curve);
 
         // -point.y % curve.p
-        fp_neg(point->ecc_point->y, point->ecc_point->y);
-        fp_mod(point->ecc_point->y, point->ecc_curve->p, point->ecc_point->y);
-
-        mp_point_t *pr = new_point_init_copy((mp_curve_t *)point);
-
-        // restore point.y
-        fp_copy(point_y_fp_int, point->ecc_point->y);
+        fp_copy(point->ecc_point->x, pr->ecc_point->x);
+        fp_neg(point->ecc_point->y, pr->ecc_point->y);
+        fp_mod(pr->ecc_point->y, point->ecc_curve->p, pr->ecc_point->y);
 
         return MP_OBJ_FROM_PTR(pr);
     }
@@ -2077,7 +7058,58 @@ static mp_obj_t point_unary_op(mp_unary_op_t op, mp_obj_t self_in)
     }
 }
 
+static mp_obj_t point_to_bytes(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    /*
+        compressed (bool): Encode only x and the parity of y
+    */
+
+    fp_scratch_enter();
+
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_compressed, MP_ARG_BOOL, {.u_bool = false}},
+    };
+
+    struct
+    {
+        mp_arg_val_t compressed;
+    } args;
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    mp_point_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    vstr_t vstr_out;
+    vstr_init_len(&vstr_out, 1 + 2 * ec_point_coordinate_len(self->ecc_curve));
+    vstr_out.len = ec_point_encode((byte *)vstr_out.buf, self->ecc_point, args.compressed.u_bool, self->ecc_curve);
+    return mp_obj_new_bytes_from_vstr(&vstr_out);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_KW(point_to_bytes_obj, 1, point_to_bytes);
+
+static mp_obj_t point_from_bytes(mp_obj_t data, mp_obj_t curve)
+{
+    fp_scratch_enter();
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(data, &bufinfo, MP_BUFFER_READ);
+    if (!MP_OBJ_IS_TYPE(curve, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(curve));
+    }
+
+    mp_point_t *pr = new_point_init_shared(((mp_curve_t *)MP_OBJ_TO_PTR(curve))->ecc_curve);
+    if (!ec_point_decode(pr->ecc_point, (const byte *)bufinfo.buf, bufinfo.len, pr->ecc_curve))
+    {
+        mp_raise_ValueError(ERROR_INVALID_POINT_ENCODING);
+    }
+    return MP_OBJ_FROM_PTR(pr);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_2(point_from_bytes_obj, point_from_bytes);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_from_bytes_obj, MP_ROM_PTR(&point_from_bytes_obj));
+
 static const mp_rom_map_elem_t point_locals_dict_table[] = {
+    {MP_ROM_QSTR(MP_QSTR_to_bytes), MP_ROM_PTR(&point_to_bytes_obj)},
+    {MP_ROM_QSTR(MP_QSTR_from_bytes), MP_ROM_PTR(&static_point_from_bytes_obj)},
     {MP_ROM_QSTR(MP_QSTR_x), MP_ROM_INT(0)},
     {MP_ROM_QSTR(MP_QSTR_y), MP_ROM_INT(0)},
     {MP_ROM_QSTR(MP_QSTR_curve), MP_ROM_PTR(mp_const_none)},
@@ -2085,10 +7117,13 @@ static const mp_rom_map_elem_t point_locals_dict_table[] = {
 
 static MP_DEFINE_CONST_DICT(point_locals_dict, point_locals_dict_table);
 
+static mp_obj_t point_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args);
+
 MP_DEFINE_CONST_OBJ_TYPE(
     point_type,
     MP_QSTR_Point,
     MP_TYPE_FLAG_NONE,
+    make_new, point_make_new,
     print, point_print,
     binary_op, point_binary_op,
     unary_op, point_unary_op,
@@ -2142,32 +7177,142 @@ static mp_obj_t point(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args
     {
         mp_curve_t *curve = MP_OBJ_TO_PTR(args.curve.u_obj);
 
-        point->ecc_curve = m_new_obj(ecc_curve_t);
-        point->ecc_curve->p = fp_alloc();
-        point->ecc_curve->a = fp_alloc();
-        point->ecc_curve->b = fp_alloc();
-        point->ecc_curve->q = fp_alloc();
-        point->ecc_curve->g = m_new_obj(ecc_point_t);
-        point->ecc_curve->g->x = fp_alloc();
-        point->ecc_curve->g->y = fp_alloc();
-
-        vstr_init(&point->ecc_curve->name, vstr_len(&curve->ecc_curve->oid));
-        vstr_add_strn(&point->ecc_curve->name, vstr_str(&curve->ecc_curve->name), vstr_len(&curve->ecc_curve->name));
-        vstr_init(&point->ecc_curve->oid, vstr_len(&curve->ecc_curve->oid));
-        vstr_add_strn(&point->ecc_curve->oid, vstr_str(&curve->ecc_curve->oid), vstr_len(&curve->ecc_curve->oid));
-
-        fp_copy(curve->ecc_curve->p, point->ecc_curve->p);
-        fp_copy(curve->ecc_curve->a, point->ecc_curve->a);
-        fp_copy(curve->ecc_curve->b, point->ecc_curve->b);
-        fp_copy(curve->ecc_curve->q, point->ecc_curve->q);
-        fp_copy(curve->ecc_curve->g->x, point->ecc_curve->g->x);
-        fp_copy(curve->ecc_curve->g->y, point->ecc_curve->g->y);
+        point->ecc_curve = curve->ecc_curve;
     }
     return MP_OBJ_FROM_PTR(point);
 }
 
-static MP_DEFINE_CONST_FUN_OBJ_KW(point_obj, 3, point);
-static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_point_obj, MP_ROM_PTR(&point_obj));
+// ECC.Point is the type itself, so that ECC.Point.from_bytes is reachable
+static mp_obj_t point_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args)
+{
+    fp_scratch_enter();
+
+    (void)type;
+    mp_map_t kw_args;
+    mp_map_init_fixed_table(&kw_args, n_kw, args + n_args);
+    return point(n_args, args, &kw_args);
+}
+
+static void public_key_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
+{
+    (void)kind;
+    mp_public_key_t *self = MP_OBJ_TO_PTR(self_in);
+    vstr_t *ecc_point_x = vstr_new_from_fp(self->point->ecc_point->x);
+    vstr_t *ecc_point_y = vstr_new_from_fp(self->point->ecc_point->y);
+    mp_printf(print, "<PublicKey x=%s y=%s curve=%s>", vstr_str(ecc_point_x), vstr_str(ecc_point_y), vstr_str(&self->point->ecc_curve->name));
+    vstr_free(ecc_point_x);
+    vstr_free(ecc_point_y);
+}
+
+static void public_key_attr(mp_obj_t obj, qstr attr, mp_obj_t *dest)
+{
+    fp_scratch_enter();
+
+    mp_public_key_t *self = MP_OBJ_TO_PTR(obj);
+    if (dest[0] == MP_OBJ_NULL)
+    {
+        const mp_obj_type_t *type = mp_obj_get_type(obj);
+        mp_map_t *locals_map = &MP_OBJ_TYPE_GET_SLOT(type, locals_dict)->map;
+        mp_map_elem_t *elem = mp_map_lookup(locals_map, MP_OBJ_NEW_QSTR(attr), MP_MAP_LOOKUP);
+        if (elem != NULL)
+        {
+            if (attr == MP_QSTR_Q)
+            {
+                mp_point_t *pr = new_point_init_shared(self->point->ecc_curve);
+                fp_copy(self->point->ecc_point->x, pr->ecc_point->x);
+                fp_copy(self->point->ecc_point->y, pr->ecc_point->y);
+                dest[0] = MP_OBJ_FROM_PTR(pr);
+                return;
+            }
+            else if (attr == MP_QSTR_curve)
+            {
+                dest[0] = new_curve_init_shared(self->point->ecc_curve);
+                return;
+            }
+            mp_convert_member_lookup(obj, type, elem->value, dest);
+        }
+    }
+}
+
+static const mp_rom_map_elem_t public_key_locals_dict_table[] = {
+    {MP_ROM_QSTR(MP_QSTR_Q), MP_ROM_PTR(mp_const_none)},
+    {MP_ROM_QSTR(MP_QSTR_curve), MP_ROM_PTR(mp_const_none)},
+};
+
+static MP_DEFINE_CONST_DICT(public_key_locals_dict, public_key_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    public_key_type,
+    MP_QSTR_PublicKey,
+    MP_TYPE_FLAG_NONE,
+    print, public_key_print,
+    attr, public_key_attr,
+    locals_dict, &public_key_locals_dict);
+
+static mp_obj_t public_key(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
+{
+    /*
+        Q (Point): The public point, checked once to be on the curve and of order q
+        curve (Curve): The curve of the point
+    */
+
+    fp_scratch_enter();
+
+    static const mp_arg_t allowed_args[] = {
+        {MP_QSTR_Q, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+        {MP_QSTR_curve, MP_ARG_OBJ, {.u_obj = mp_const_none}},
+    };
+
+    struct
+    {
+        mp_arg_val_t Q, curve;
+    } args;
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, (mp_arg_val_t *)&args);
+
+    if (!MP_OBJ_IS_TYPE(args.Q.u_obj, &point_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_POINT_AT_BUT, 1, mp_obj_get_type_str(args.Q.u_obj));
+    }
+    if (!MP_OBJ_IS_TYPE(args.curve.u_obj, &curve_type))
+    {
+        mp_raise_msg_varg(&mp_type_TypeError, ERROR_EXPECTED_CURVE_AT_BUT, 2, mp_obj_get_type_str(args.curve.u_obj));
+    }
+
+    mp_point_t *q = MP_OBJ_TO_PTR(args.Q.u_obj);
+    mp_curve_t *c = MP_OBJ_TO_PTR(args.curve.u_obj);
+
+    mp_public_key_t *pk = m_new_obj(mp_public_key_t);
+    pk->base.type = &public_key_type;
+    pk->point = new_point_init_shared(c->ecc_curve);
+    fp_mod(q->ecc_point->x, c->ecc_curve->p, pk->point->ecc_point->x);
+    fp_mod(q->ecc_point->y, c->ecc_curve->p, pk->point->ecc_point->y);
+
+    // not the identity element, on the curve and q * Q = identity
+    bool valid = !(fp_iszero(pk->point->ecc_point->x) == FP_YES && fp_iszero(pk->point->ecc_point->y) == FP_YES) && ec_point_in_curve(pk->point->ecc_point, c->ecc_curve);
+    if (valid)
+    {
+        ecc_point_t *R = m_new_obj(ecc_point_t);
+        R->x = fp_alloc_scratch();
+        R->y = fp_alloc_scratch();
+
+        ec_point_mul_wnaf(R, pk->point->ecc_point, c->ecc_curve->q, c->ecc_curve);
+        valid = (fp_iszero(R->x) == FP_YES && fp_iszero(R->y) == FP_YES);
+
+        fp_free(R->x);
+        fp_free(R->y);
+        m_del_obj(ecc_point_t, R);
+    }
+    if (!valid)
+    {
+        mp_raise_ValueError(ERROR_INVALID_PUBLIC_KEY);
+    }
+
+    pk->odd = ec_odd_multiples_new(pk->point->ecc_point, ECC_PUBLIC_KEY_WNAF_WINDOW_BITS, pk->point->ecc_curve);
+    return MP_OBJ_FROM_PTR(pk);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_KW(public_key_obj, 2, public_key);
+static MP_DEFINE_CONST_STATICMETHOD_OBJ(static_public_key_obj, MP_ROM_PTR(&public_key_obj));
 
 static void ecc_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind)
 {
@@ -2176,18 +7321,27 @@ static void ecc_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t
 }
 
 static const mp_rom_map_elem_t ecc_locals_dict_table[] = {
-    {MP_ROM_QSTR(MP_QSTR_Point), MP_ROM_PTR(&static_point_obj)},
+    {MP_ROM_QSTR(MP_QSTR_Point), MP_ROM_PTR(&point_type)},
     {MP_ROM_QSTR(MP_QSTR_point_equal), MP_ROM_PTR(&static_point_equal_obj)},
     {MP_ROM_QSTR(MP_QSTR_point_double), MP_ROM_PTR(&static_point_double_obj)},
     {MP_ROM_QSTR(MP_QSTR_point_add), MP_ROM_PTR(&static_point_add_obj)},
     {MP_ROM_QSTR(MP_QSTR_point_sub), MP_ROM_PTR(&static_point_sub_obj)},
     {MP_ROM_QSTR(MP_QSTR_point_mul), MP_ROM_PTR(&static_point_mul_obj)},
-    {MP_ROM_QSTR(MP_QSTR_Curve), MP_ROM_PTR(&static_curve_obj)},
+    {MP_ROM_QSTR(MP_QSTR_normalize_batch), MP_ROM_PTR(&static_normalize_batch_obj)},
+    {MP_ROM_QSTR(MP_QSTR_msm), MP_ROM_PTR(&static_msm_obj)},
+    {MP_ROM_QSTR(MP_QSTR_Curve), MP_ROM_PTR(&curve_type)},
     {MP_ROM_QSTR(MP_QSTR_curve_equal), MP_ROM_PTR(&static_curve_equal_obj)},
     {MP_ROM_QSTR(MP_QSTR_point_in_curve), MP_ROM_PTR(&static_point_in_curve_obj)},
     {MP_ROM_QSTR(MP_QSTR_Signature), MP_ROM_PTR(&static_signature_obj)},
+    {MP_ROM_QSTR(MP_QSTR_PublicKey), MP_ROM_PTR(&static_public_key_obj)},
     {MP_ROM_QSTR(MP_QSTR_ecdsa_sign), MP_ROM_PTR(&static_ecdsa_sign_obj)},
     {MP_ROM_QSTR(MP_QSTR_ecdsa_verify), MP_ROM_PTR(&static_ecdsa_verify_obj)},
+    {MP_ROM_QSTR(MP_QSTR_ecdsa_verify_batch), MP_ROM_PTR(&static_ecdsa_verify_batch_obj)},
+    {MP_ROM_QSTR(MP_QSTR_ecdh), MP_ROM_PTR(&static_ecdh_obj)},
+    {MP_ROM_QSTR(MP_QSTR_x25519), MP_ROM_PTR(&static_x25519_obj)},
+    {MP_ROM_QSTR(MP_QSTR_ed25519_public_key), MP_ROM_PTR(&static_ed25519_public_key_obj)},
+    {MP_ROM_QSTR(MP_QSTR_ed25519_sign), MP_ROM_PTR(&static_ed25519_sign_obj)},
+    {MP_ROM_QSTR(MP_QSTR_ed25519_verify), MP_ROM_PTR(&static_ed25519_verify_obj)},
 };
 
 static MP_DEFINE_CONST_DICT(ecc_locals_dict, ecc_locals_dict_table);
@@ -2199,8 +7353,50 @@ MP_DEFINE_CONST_OBJ_TYPE(
     print, ecc_print,
     locals_dict, &ecc_locals_dict);
 
+// the heap doesn't survive a soft reset, neither do the curves in the registry, the scratch pool starts over
+static mp_obj_t mod_init(void)
+{
+#if ECC_CURVE_REGISTRY
+    memset(MP_STATE_VM(ucrypto_curves), 0, sizeof(MP_STATE_VM(ucrypto_curves)));
+#endif
+#if FP_SCRATCH_POOL_SIZE > 0
+    fp_scratch_reset();
+#endif
+    return mp_const_none;
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_0(mod_init_obj, mod_init);
+
+#if FP_ALLOC_STATS
+// (heap, scratch, fallback, peak) since the last call, to count the allocations of an operation
+static mp_obj_t mod_alloc_stats(void)
+{
+    mp_obj_t items[4] = {
+        mp_obj_new_int_from_uint(fp_alloc_stats.heap),
+        mp_obj_new_int_from_uint(fp_alloc_stats.scratch),
+        mp_obj_new_int_from_uint(fp_alloc_stats.fallback),
+        mp_obj_new_int_from_uint(fp_alloc_stats.peak),
+    };
+    fp_alloc_stats.heap = 0;
+    fp_alloc_stats.scratch = 0;
+    fp_alloc_stats.fallback = 0;
+#if FP_SCRATCH_POOL_SIZE > 0
+    fp_alloc_stats.peak = fp_scratch_live;
+#else
+    fp_alloc_stats.peak = 0;
+#endif
+    return mp_obj_new_tuple(4, items);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_0(mod_alloc_stats_obj, mod_alloc_stats);
+#endif
+
 static const mp_rom_map_elem_t mp_module_ucrypto_globals_table[] = {
     {MP_OBJ_NEW_QSTR(MP_QSTR___name__), MP_OBJ_NEW_QSTR(MP_QSTR__crypto)},
+    {MP_ROM_QSTR(MP_QSTR___init__), MP_ROM_PTR(&mod_init_obj)},
+#if FP_ALLOC_STATS
+    {MP_ROM_QSTR(MP_QSTR_alloc_stats), MP_ROM_PTR(&mod_alloc_stats_obj)},
+#endif
     {MP_ROM_QSTR(MP_QSTR_ECC), MP_ROM_PTR(&ecc_type)},
     {MP_ROM_QSTR(MP_QSTR_NUMBER), MP_ROM_PTR(&number_type)},
 };
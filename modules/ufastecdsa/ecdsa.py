@@ -55,3 +55,25 @@ def verify(signature, message, Q, curve=P256, hashfunc=hashlib.sha256):
     digest = hashfunc(message).digest()
     hex_digest = binascii.hexlify(digest)
     return _crypto.ECC.ecdsa_verify(signature, hex_digest, Q._point, curve._curve)
+
+
+def verify_batch(items, curve=P256, hashfunc=hashlib.sha256):
+    batch = []
+    for signature, message, Q in items:
+        if isinstance(signature, (tuple, list)):
+            signature = Signature(signature[0], signature[1])
+        if isinstance(signature, Signature):
+            signature = _crypto.ECC.Signature(signature.r, signature.s)
+
+        if not isinstance(Q, Point):
+            raise EcdsaError("Invalid public key: point must be of type Point")
+
+        if not Q._point in curve._curve:
+            raise EcdsaError(
+                "Invalid public key: point is not on curve {0}".format(curve.name)
+            )
+
+        digest = hashfunc(message).digest()
+        hex_digest = binascii.hexlify(digest)
+        batch.append((signature, hex_digest, Q._point))
+    return _crypto.ECC.ecdsa_verify_batch(batch, curve._curve)
@@ -1,7 +1,7 @@
 # coding=utf-8
 # pylint: disable=E0401
 import _crypto
-from ufastecdsa.curve import Curve, P256
+from ufastecdsa.curve import P256
 
 
 class CurveMismatchError(Exception):
@@ -17,20 +17,11 @@ class Point(object):
              x = x % curve.p
              y = y % curve.p
 
-        if not _crypto.ECC.Point(x, y, curve._curve) in curve._curve:
+        self._point = _crypto.ECC.Point(x, y, curve._curve)
+        if not self._point in curve._curve:
             raise ValueError("not on curve <{}>".format(curve.name))
 
-        self._point = _crypto.ECC.Point(x, y, curve._curve)
-        self._curve = Curve(
-            self._point.curve.name,
-            self._point.curve.p,
-            self._point.curve.a,
-            self._point.curve.b,
-            self._point.curve.q,
-            self._point.curve.gx,
-            self._point.curve.gy,
-            oid=self._point.curve.oid,
-        )
+        self._curve = curve
 
     def __str__(self):
         return "<Point x=0x{:x} y=0x{:x} curve={!s}>".format(
@@ -83,13 +74,9 @@ class Point(object):
         return self._curve
 
     def dumps(self, use_compression=False):
-        if not use_compression:
-            return (
-                b"\x04"
-                + self._point.x.to_bytes(32, "big")
-                + self._point.y.to_bytes(32, "big")
-            )
-        elif self._point.y % 2 == 0:
-            return b"\x02" + self._point.x.to_bytes(32, "big")
-        else:
-            return b"\x03" + self._point.x.to_bytes(32, "big")
+        return self._point.to_bytes(compressed=use_compression)
+
+    @staticmethod
+    def loads(data, curve=P256):
+        p = _crypto.ECC.Point.from_bytes(data, curve._curve)
+        return Point(p.x, p.y, curve=curve)
@@ -51,6 +51,18 @@ s = 8915912886303431367515079869141824601673067160322484813644526373885722145766
 p3_mul_s = ECC.point_mul(p3, s, P256)
 print("p3_mul_s =", hex(p3_mul_s.x), hex(p3_mul_s.y))
 
+p3_mul_s_public = ECC.point_mul(p3, s, P256, public=True)
+print("p3_mul_s_public =", p3_mul_s_public == p3_mul_s)
+
+z = 0x1234567890abcdef
+p3_jacobian = (p3.x * z * z, p3.y * z * z * z, z)
+p3_normalized = ECC.normalize_batch([p3_jacobian, (p3.x, p3.y, 1), (1, 1, 0)], P256)
+print("p3_normalized =", p3_normalized[0] == p3, p3_normalized[1] == p3, p3_normalized[2].x, p3_normalized[2].y)
+
+p3_msm = ECC.msm([p3, p4, p3], [s, 0, -s], P256)
+p3_msm_many = ECC.msm([p3] * 100 + [p4], [s] * 100 + [-100 * s], P256)
+print("p3_msm =", p3_msm.x, p3_msm.y, p3_msm_many == ECC.point_mul(p3 - p4, 100 * s, P256))
+
 MSG1 = "7c3e883ddc8bd688f96eac5e9324222c8f30f9d6bb59e9c5f020bd39ba2b8377"
 
 def sig_1():
@@ -68,6 +80,13 @@ Q = ECC.Point(
 
 print("verify =", ECC.ecdsa_verify(signature, MSG1, Q, P256))
 
+Q_key = ECC.PublicKey(Q, P256)
+print("verify public key =", ECC.ecdsa_verify(signature, MSG1, Q_key, P256), Q_key.Q == Q)
+try:
+    ECC.PublicKey(ECC.Point(Q.x, Q.y + 1, P256), P256)
+except ValueError as e:
+    print("ValueError:", e)
+
 MSG2 = "39a5e04aaff7455d9850c605364f514c11324ce64016960d23d5dc57d3ffd8f49a739468ab8049bf18eef820cdb1ad6c9015f838556bc7fad4138b23fdf986c7"
 def sig_2():
     d2 = 91225253027397101270059260515990221874496108017261222445699397644687913215777
@@ -75,3 +94,9 @@ def sig_2():
     return ECC.ecdsa_sign(MSG2, d2, k2, P256)
 signature2 = sig_2()
 print("signature =", hex(signature2.r), hex(signature2.s))
+
+# the field elements have room for the largest enabled curve, P-521
+try:
+    ECC.Curve(2**607 - 1, -3, 7, 2**607 - 1, 1, 2)
+except ValueError as e:
+    print("ValueError:", e)
@@ -0,0 +1,72 @@
+try:
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P256 = (
+    0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+    -0x3,
+    0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b,
+    0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551,
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+)
+
+SECP256K1 = (
+    0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f,
+    0x0,
+    0x7,
+    0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141,
+    0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798,
+    0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8,
+)
+
+# curve25519 in Weierstrass form, cofactor 8
+W25519 = (
+    0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed,
+    0x2aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa984914a144,
+    0x7b425ed097b425ed097b425ed097b425ed097b425ed097b4260b5e9c7710c864,
+    0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed,
+    0x2aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaad245a,
+    0x20ae19a1b8a086b4e01edd2c7748d14c923d4d7e6d7c61b229e9c5a27eced3d9,
+)
+
+def test():
+    for name, params in (("P256", P256), ("secp256k1", SECP256K1)):
+        curve = ECC.Curve(*params, name=name)
+        complete = ECC.Curve(*params, name=name, complete=True)
+        print(name, curve.complete, complete.complete)
+
+        P = 0xc0ffee * curve.G
+        Q = 0xc0ffee * complete.G
+        print(name, "G", P.x == Q.x and P.y == Q.y)
+
+        for k in (1, 2, 3, 0xdeadbeef, curve.q - 1, curve.q, curve.q + 1, -5, 2 ** 300 + 7):
+            R = k * P
+            S = k * ECC.Point(P.x, P.y, complete)
+            print(name, k == curve.q, R.x == S.x and R.y == S.y)
+
+        complete.complete = False
+        print(name, complete.complete)
+
+    # the complete formulas and the ladder mod q are right on prime order curves only
+    try:
+        ECC.Curve(*W25519, name="W25519", complete=True)
+    except ValueError as e:
+        print("ValueError:", e)
+
+    curve = ECC.Curve(*W25519, name="W25519")
+    try:
+        curve.complete = True
+    except ValueError as e:
+        print("ValueError:", e)
+    print("W25519", curve.complete)
+
+    # a point of order 8q keeps its multiples past q
+    P = ECC.Point(0xc, 0x3bfab897dcebc3c187739a700ae075169afa801a7f0bac450f4fba9abf3f3696, curve)
+    print("W25519", (2 ** 300 * P) == ((2 ** 300 % (8 * curve.q)) * P), (curve.q * P).x != 0)
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,52 @@
+try:
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P256 = ECC.Curve(
+    0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+    0xffffffff00000001000000000000000000000000fffffffffffffffffffffffc,
+    0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b,
+    0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551,
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+    name='P256',
+    oid="2a8648ce3d030107" # b'\x2A\x86\x48\xCE\x3D\x03\x01\x07'
+)
+
+def test():
+    P = 0xc0ffee * P256.G
+    Q = P + P256.G
+    print("curve", P.curve == P256, Q.curve == P256)
+    print("P + Q - Q", P + Q - Q == P)
+
+    N = -P
+    print("-P", N.x == P.x, N.y == P256.p - P.y, (P + N).x, (P + N).y)
+
+    # the points keep the curve they were made on
+    curve = P.curve
+    curve.b = 7
+    curve.name = "other"
+    print("points", P.curve == P256, P.curve.name, curve.name)
+    print("b", P.curve.b == P256.b, curve.b)
+
+    # curves made with the same parameters are interned, the named ones are built in and found by oid
+    C = ECC.Curve.from_oid("2a8648ce3d030107")
+    print("from_oid", C == P256, C.name, (0xc0ffee * C.G) == P)
+    print("from_oid bytes", ECC.Curve.from_oid(b"\x2A\x86\x48\xCE\x3D\x03\x01\x07").name)
+    P384 = ECC.Curve.from_oid("2b81040022")
+    print("from_oid P384", P384.name, P384.q.bit_length(), (P384.q - 1) * P384.G == -P384.G)
+    try:
+        ECC.Curve.from_oid("2b810400ff")
+    except ValueError as e:
+        print("ValueError:", e)
+
+    # a changed curve is found again like a new one
+    curve.b = P256.b
+    curve.name = "P256"
+    print("changed back", curve == P256, (0xc0ffee * curve.G) == P)
+
+
+if __name__ == "__main__":
+    test()
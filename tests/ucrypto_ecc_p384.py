@@ -0,0 +1,50 @@
+try:
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P384 = ECC.Curve(
+    0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFFFF0000000000000000FFFFFFFF,
+    -0x3,
+    0xB3312FA7E23EE7E4988E056BE3F82D19181D9C6EFE8141120314088F5013875AC656398D8A2ED19D2A85C8EDD3EC2AEF,
+    0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFC7634D81F4372DDF581A0DB248B0A77AECEC196ACCC52973,
+    0xAA87CA22BE8B05378EB1C71EF320AD746E1D3B628BA79B9859F741E082542A385502F25DBF55296C3A545E3872760AB7,
+    0x3617DE4A96262C6F5D9E98BF9292DC29F8F41DBD289A147CE9DA3113B5F0B8C00A60B1CE1D7E819D7A431D7C90EA0E5F,
+)
+
+S = ECC.Point(
+    0x69A14B30480EFFDD62B8E2EFBE04B90CD3D654C283C6177BE553C35E4CDD63B90AED13E8BC8CB8319766D9EB4486E373,
+    0x74F00D0124CC84FB668BB69AA0F6D0E6ED7DD3DBB253DF1011EAB820A764364D4CB596431AEEF4A36811AC19ADF96146,
+    P384,
+)
+
+T = ECC.Point(
+    0x1BA9A56D7CB05F19643493C57ECD63FD806C632500658815AE5E70C7957009C1F5E791A9D2C5CC3B0B248D2DD8BAA4F2,
+    0x6596D3F2275E44E98F2C718EF528147270C3DF53582E835E963AFFA7F968B64425F92A98B61EAF8F03EF242899E748EA,
+    P384,
+)
+
+print("S==S  = ", S == S)
+
+print("S==T  = ", S == T)
+
+R = S + T
+print(f"S+T   = ({R.x:x}, {R.y:x})")
+
+R = S - T
+print(f"S-T   = ({R.x:x}, {R.y:x})")
+
+R = 2 * S
+print(f"2S    = ({R.x:x}, {R.y:x})")
+
+d = 0x94F7B3F7B62F1E12BADA78D09420DDF2B93D6DFCACE2007248F85DCBD4D9C5252EB1616A726C1F5464D4AF1422DB91D1
+e = 0x913DFF386F0EE379E7DCCBEB67235E51E011B7627C43365B7E6C6B03DEE43ED7651AFD26EADEADA66E7CDC0CA2446908
+R = (d * S) + (e * T)
+print(f"dS+eT = ({R.x:x}, {R.y:x})")
+
+R = S + S
+print(f"S+S   = ({R.x:x}, {R.y:x})")
+
+R = S - S
+print(f"S-S   = ({R.x:x}, {R.y:x})")
@@ -0,0 +1,50 @@
+try:
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P521 = ECC.Curve(
+    0x1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF,
+    -0x3,
+    0x51953EB9618E1C9A1F929A21A0B68540EEA2DA725B99B315F3B8B489918EF109E156193951EC7E937B1652C0BD3BB1BF073573DF883D2C34F1EF451FD46B503F00,
+    0x1FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFA51868783BF2F966B7FCC0148F709A5D03BB5C9B8899C47AEBB6FB71E91386409,
+    0xC6858E06B70404E9CD9E3ECB662395B4429C648139053FB521F828AF606B4D3DBAA14B5E77EFE75928FE1DC127A2FFA8DE3348B3C1856A429BF97E7E31C2E5BD66,
+    0x11839296A789A3BC0045C8A5FB42C7D1BD998F54449579B446817AFBD17273E662C97EE72995EF42640C550B9013FAD0761353C7086A272C24088BE94769FD16650,
+)
+
+S = ECC.Point(
+    0x12AD95285A2E60D3C0002BED605879106C6F5082B5BB5C8D7016FB0CA8AF690D51547AFD111E3D196AB4F54132708DE9D8FBA82A0A2AF59AFA1074E1C82BA014347,
+    0x1AC9EC14BEC94219296E8974A7417123F5B37D3C2F9BA3A7553FEF71DFB48F11B7E2E64D33415E32579D6F8E89128DBA2D9273AD28C49B7BC141A08639BFC7089CD,
+    P521,
+)
+
+T = ECC.Point(
+    0x1CD25358769CAAA02E8FEC0A56EE4A849BF6CC444062AC941018F417D9B182AAF6E4CACAD00E6654BC5B3110A5053BCBEE1A14BE88938452FC87733B74511596493,
+    0x8E3B5660B7D859EFE7DC9B6E53D649907B38EFED52A7A8296D3E410E959877D5A17B051B1299E8E88D1F58327EA3D7726BA1CB7CD81B6EB76DE64933B67686B3EC,
+    P521,
+)
+
+print("S==S  = ", S == S)
+
+print("S==T  = ", S == T)
+
+R = S + T
+print(f"S+T   = ({R.x:x}, {R.y:x})")
+
+R = S - T
+print(f"S-T   = ({R.x:x}, {R.y:x})")
+
+R = 2 * S
+print(f"2S    = ({R.x:x}, {R.y:x})")
+
+d = 0xDDF03AE2E0850B1F2607407F1AE4ABFA18A2FE068B3B133F2B3CF1DB95283E7D89E859899053C54F0E41C688CCF897B86FE8EA44DC7690B75706577990B4E91486
+e = 0xEF2B77858B5CCCC8115DB207834237AE39F2E7C6D946C48BA856AC5E362976C6A0652DCA851EA4613AC501CCD6436B80BCD9221441A153F4ED00AE170E142445F2
+R = (d * S) + (e * T)
+print(f"dS+eT = ({R.x:x}, {R.y:x})")
+
+R = S + S
+print(f"S+S   = ({R.x:x}, {R.y:x})")
+
+R = S - S
+print(f"S-S   = ({R.x:x}, {R.y:x})")
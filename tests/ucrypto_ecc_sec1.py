@@ -0,0 +1,43 @@
+try:
+    from ubinascii import hexlify
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P256 = ECC.Curve(
+    0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+    -0x3,
+    0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b,
+    0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551,
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+    name='P256',
+    oid="2a8648ce3d030107" # b'\x2A\x86\x48\xCE\x3D\x03\x01\x07'
+)
+
+def test():
+    G = P256.G
+    print("G =", hexlify(G.to_bytes()).decode())
+    print("G compressed =", hexlify(G.to_bytes(compressed=True)).decode())
+
+    for k in (1, 2, 0xc0ffee, P256.q - 1):
+        Q = k * G
+        for compressed in (False, True):
+            data = Q.to_bytes(compressed=compressed)
+            R = ECC.Point.from_bytes(data, P256)
+            print(k, len(data), R == Q)
+
+    print("identity =", ECC.Point.from_bytes(b"\x00", P256).to_bytes())
+
+    # not on the curve, bad prefix, truncated
+    data = G.to_bytes()
+    for bad in (data[:-1] + bytes([data[-1] ^ 1]), b"\x05" + data[1:33], data[:32]):
+        try:
+            ECC.Point.from_bytes(bad, P256)
+        except ValueError as e:
+            print("ValueError:", e)
+
+
+if __name__ == "__main__":
+    test()
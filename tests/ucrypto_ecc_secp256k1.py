@@ -0,0 +1,50 @@
+try:
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+SECP256K1 = ECC.Curve(
+    0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEFFFFFC2F,
+    0x0,
+    0x7,
+    0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFEBAAEDCE6AF48A03BBFD25E8CD0364141,
+    0x79BE667EF9DCBBAC55A06295CE870B07029BFCDB2DCE28D959F2815B16F81798,
+    0x483ADA7726A3C4655DA4FBFC0E1108A8FD17B448A68554199C47D08FFB10D4B8,
+)
+
+S = ECC.Point(
+    0xAEEE6FA56D9117EA1ED6380B85259A1A47FD32D6A6C1DAE1C9A7E4F7673883C2,
+    0x4249F2466CF01E603E6EA360A004343DB643AAECD52C9AC38D71665808843FDA,
+    SECP256K1,
+)
+
+T = ECC.Point(
+    0xD50D5D95A8775E9DF10CAE4255479398D5F1BCE9D94B5D93E3D88EDF9869DF1A,
+    0x805B09E4D6BA75D1F5A1D98DBDFDA053F9F75204ED8B06775850D23E3E7574F7,
+    SECP256K1,
+)
+
+print("S==S  = ", S == S)
+
+print("S==T  = ", S == T)
+
+R = S + T
+print(f"S+T   = ({R.x:x}, {R.y:x})")
+
+R = S - T
+print(f"S-T   = ({R.x:x}, {R.y:x})")
+
+R = 2 * S
+print(f"2S    = ({R.x:x}, {R.y:x})")
+
+d = 0xD2AEEAF914C7D3FD9A1AC067541B8EE6F0969FE15284B2BF8E56916A518A4445
+e = 0xF09B30460CCE5B3445FFF12FB4D7A20D294B97D08E7981664997082C8B7E20C0
+R = (d * S) + (e * T)
+print(f"dS+eT = ({R.x:x}, {R.y:x})")
+
+R = S + S
+print(f"S+S   = ({R.x:x}, {R.y:x})")
+
+R = S - S
+print(f"S-S   = ({R.x:x}, {R.y:x})")
@@ -0,0 +1,66 @@
+try:
+    from ubinascii import hexlify
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P256 = ECC.Curve(
+    0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+    -0x3,
+    0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b,
+    0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551,
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+    name='P256',
+    oid="2a8648ce3d030107" # b'\x2A\x86\x48\xCE\x3D\x03\x01\x07'
+)
+
+# curve25519 in Weierstrass form, cofactor 8
+W25519 = ECC.Curve(
+    0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed,
+    0x2aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa984914a144,
+    0x7b425ed097b425ed097b425ed097b425ed097b425ed097b4260b5e9c7710c864,
+    0x1000000000000000000000000000000014def9dea2f79cd65812631a5cf5d3ed,
+    0x2aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaad245a,
+    0x20ae19a1b8a086b4e01edd2c7748d14c923d4d7e6d7c61b229e9c5a27eced3d9,
+    name='W25519'
+)
+
+def test():
+    d_a = 0xf3fccc0d00d8031954f90864d43c247f4bf5f0665c6b50cc17749a27d1cf7664
+    d_b = 0xc9afa9d845ba75166b5c215767b1d6934e50c3db36e89b127b8a622b120f6721
+    Q_a = d_a * P256.G
+    Q_b = d_b * P256.G
+
+    secret_a = ECC.ecdh(d_a, Q_b, P256)
+    secret_b = ECC.ecdh(d_b, ECC.PublicKey(Q_a, P256), P256)
+    print("len =", len(secret_a))
+    print("agree =", secret_a == secret_b)
+    print("x =", secret_a == (d_a * Q_b).x.to_bytes(32, "big"))
+    print("edge =", ECC.ecdh(P256.q - 1, Q_a, P256) == Q_a.x.to_bytes(32, "big"))
+
+    for d in (0, P256.q):
+        try:
+            ECC.ecdh(d, Q_b, P256)
+        except ValueError as e:
+            print("ValueError:", e)
+
+    try:
+        ECC.ecdh(d_a, ECC.Point(Q_b.x, Q_b.y + 1, P256), P256)
+    except ValueError as e:
+        print("ValueError:", e)
+
+    # a point of order 8q on a curve with cofactor: d * Q, not (d + q) * Q
+    Q = ECC.Point(0xc, 0x3bfab897dcebc3c187739a700ae075169afa801a7f0bac450f4fba9abf3f3696, W25519)
+    d = 0xc0ffee1234567890abcdef
+    print("cofactor =", ECC.ecdh(d, Q, W25519) == (d * Q).x.to_bytes(32, "big"))
+    print("cofactor x =", hexlify(ECC.ecdh(d, Q, W25519)))
+    print("cofactor G =", ECC.ecdh(d, W25519.G, W25519) == (d * W25519.G).x.to_bytes(32, "big"))
+    # small d walk the ladder on k + 2hq through points of order 8, 4 and 2
+    for d in (1, 2, 3, 8, W25519.q - 1):
+        print("cofactor", hex(d), "=", ECC.ecdh(d, Q, W25519) == (d * Q).x.to_bytes(32, "big"))
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,42 @@
+try:
+    from ubinascii import hexlify
+    from uhashlib import sha256
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+P256 = ECC.Curve(
+    0xffffffff00000001000000000000000000000000ffffffffffffffffffffffff,
+    -0x3,
+    0x5ac635d8aa3a93e7b3ebbd55769886bc651d06b0cc53b0f63bce3c3e27d2604b,
+    0xffffffff00000000ffffffffffffffffbce6faada7179e84f3b9cac2fc632551,
+    0x6b17d1f2e12c4247f8bce6e563a440f277037d812deb33a0f4a13945d898c296,
+    0x4fe342e2fe1a7f9b8ee7eb4a7c0f9e162bce33576b315ececbb6406837bf51f5,
+    name='P256',
+    oid="2a8648ce3d030107" # b'\x2A\x86\x48\xCE\x3D\x03\x01\x07'
+)
+
+def test():
+    d = 0xf3fccc0d00d8031954f90864d43c247f4bf5f0665c6b50cc17749a27d1cf7664
+    Q = d * P256.G
+
+    items = []
+    for i in range(20):
+        digest = hexlify(sha256("message {}".format(i)).digest()).decode()
+        k = 0xc0ffee + i * 977
+        signature = ECC.ecdsa_sign(digest, d, k, P256)
+        items.append((signature, digest, Q))
+
+    print("single =", all(ECC.ecdsa_verify(s, e, q, P256) for s, e, q in items))
+    print("batch =", ECC.ecdsa_verify_batch(items, P256))
+
+    # a digest swapped between two signatures
+    items[3], items[7] = (items[3][0], items[7][1], Q), (items[7][0], items[3][1], Q)
+    print("batch swapped =", ECC.ecdsa_verify_batch(items, P256))
+
+    print("batch empty =", ECC.ecdsa_verify_batch([], P256))
+
+
+if __name__ == "__main__":
+    test()
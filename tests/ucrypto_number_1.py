@@ -75,6 +75,19 @@ print(invmod(x1, y1))
 end = ticks_ms()
 print("invmod", ticks_diff(end, start))
 
+
+def invmod_many(values, modulus):
+    return tomsfastmath.invmod_many(values, modulus)
+
+
+m = (1 << 127) - 1
+values = [random.randint(1, sys.maxsize) for i in range(64)]
+start = ticks_ms()
+inverses = invmod_many(values, m)
+end = ticks_ms()
+print(all((v * i) % m == 1 for v, i in zip(values, inverses)))
+print("invmod_many", ticks_diff(end, start))
+
 ################################################################################
 
 
@@ -0,0 +1,20 @@
+try:
+    from _crypto import NUMBER as tomsfastmath
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+M = (1 << 2000) + 1
+
+def test():
+    # around the small int limits and the limb and digit boundaries
+    values = [0, 1, 2, 0xffff, 0x10000]
+    for n in (15, 16, 30, 31, 32, 62, 63, 64, 128, 521, 1999):
+        values += [(1 << n) - 1, 1 << n, (1 << n) + 1]
+
+    for x in values:
+        print(x.bit_length(), tomsfastmath.exptmod(x, 1, M) == x, tomsfastmath.exptmod(-x, 1, M) == (M - x) % M, tomsfastmath.gcd(x, 0) == x)
+
+
+if __name__ == "__main__":
+    test()
@@ -0,0 +1,44 @@
+try:
+    from ubinascii import hexlify, unhexlify
+    from _crypto import ECC
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# RFC 7748, 5.2
+K1 = unhexlify("a546e36bf0527c9d3b16154b82465edd62144c0ac1fc5a18506a2244ba449ac4")
+U1 = unhexlify("e6db6867583030db3594c1a424b15f7c726624ec26b3353b10a903a6d0ab1c4c")
+K2 = unhexlify("4b66e9d4d1b4673c5ad22691957d6af5c11b6421e0ea01d42ca4169e7918ba0d")
+U2 = unhexlify("e5210f12786811d3f4b7959d0538ae2c31dbe7106fc03c3efc4cd549c715a493")
+
+# RFC 7748, 6.1
+ALICE = unhexlify("77076d0a7318a57d3c16c17251b26645df4c2f87ebc0992ab177fba51db92c2a")
+BOB = unhexlify("5dab087e624a8a4b79e17f8b83800ee66f3bb1292618b6fd1c2f8b27ff88e0eb")
+BASE = b"\x09" + bytes(31)
+
+def test():
+    print("x25519 1 =", hexlify(ECC.x25519(K1, U1)).decode())
+    print("x25519 2 =", hexlify(ECC.x25519(K2, U2)).decode())
+
+    k = u = BASE
+    for i in range(1000):
+        k, u = ECC.x25519(k, u), k
+        if i == 0:
+            print("iterated 1 =", hexlify(k).decode())
+    print("iterated 1000 =", hexlify(k).decode())
+
+    alice_public = ECC.x25519(ALICE, BASE)
+    bob_public = ECC.x25519(BOB, BASE)
+    print("alice public =", hexlify(alice_public).decode())
+    print("bob public =", hexlify(bob_public).decode())
+    shared = ECC.x25519(ALICE, bob_public)
+    print("shared =", hexlify(shared).decode(), shared == ECC.x25519(BOB, alice_public))
+
+    try:
+        ECC.x25519(ALICE[:31], BASE)
+    except ValueError as e:
+        print("ValueError:", e)
+
+
+if __name__ == "__main__":
+    test()
@@ -147,9 +147,10 @@
 
 // #define TFM_ECC192
 // #define TFM_ECC224
-// #define TFM_ECC256
-// #define TFM_ECC384
+#define TFM_ECC256
+#define TFM_ECC384
 // #define TFM_ECC512
+#define TFM_ECC521
 // #define TFM_RSA512
 // #define TFM_RSA1024
 // #define TFM_RSA2048